@@ -44,6 +44,10 @@ void AARPlaneActor::BeginPlay()
 void AARPlaneActor::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	if (!IsValid(ARCorePlaneObject))
+		return;
+
 	PlanePolygonMeshComponent->SetWorldTransform(ARCorePlaneObject->GetLocalToWorldTransform());
 
 	switch (ARCorePlaneObject->GetTrackingState())
@@ -60,6 +64,18 @@ void AARPlaneActor::Tick(float DeltaTime)
 	}
 }
 
+void AARPlaneActor::OnAcquiredFromPool()
+{
+	if (IsValid(PlaneMaterial))
+		PlaneMaterial->SetScalarParameterValue("TextureRotationAngle", FMath::RandRange(0.0f, 1.0f));
+}
+
+void AARPlaneActor::OnReleasedToPool()
+{
+	ARCorePlaneObject = nullptr;
+	PlanePolygonMeshComponent->ClearMeshSection(0);
+}
+
 void AARPlaneActor::SetColor(FColor InColor)
 {
 	PlaneColor = InColor;
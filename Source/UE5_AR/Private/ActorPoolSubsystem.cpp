@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorPoolSubsystem.h"
+
+AActor* UActorPoolSubsystem::Acquire(UClass* Class, const FTransform& Transform)
+{
+	if (!IsValid(Class))
+		return nullptr;
+
+	AActor* Actor = nullptr;
+	auto* FreeList = FreeActors.Find(Class);
+
+	// Pooled actors can be destroyed from outside, e.g. by a level change
+	while (FreeList && FreeList->Actors.Num() > 0 && !IsValid(Actor))
+	{
+		Actor = FreeList->Actors.Pop(false);
+		PooledActors.Remove(Actor);
+	}
+
+	if (!IsValid(Actor))
+		return GetWorld()->SpawnActor(Class, &Transform);
+
+	Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorActive(Actor, true);
+
+	if (auto* Poolable = Cast<IPoolableActor>(Actor))
+		Poolable->OnAcquiredFromPool();
+
+	return Actor;
+}
+
+void UActorPoolSubsystem::Release(AActor* Actor)
+{
+	if (!IsValid(Actor) || IsInPool(Actor))
+		return;
+
+	auto& FreeList = FreeActors.FindOrAdd(Actor->GetClass());
+
+	if (FreeList.Actors.Num() >= MaxFreeActorsPerClass)
+	{
+		GetWorld()->DestroyActor(Actor);
+		return;
+	}
+
+	if (auto* Poolable = Cast<IPoolableActor>(Actor))
+		Poolable->OnReleasedToPool();
+
+	SetActorActive(Actor, false);
+	FreeList.Actors.Add(Actor);
+	PooledActors.Add(Actor);
+}
+
+void UActorPoolSubsystem::Prewarm(UClass* Class, const int32 Count)
+{
+	if (!IsValid(Class))
+		return;
+
+	auto& FreeList = FreeActors.FindOrAdd(Class);
+	const int32 TargetCount = FMath::Min(Count, MaxFreeActorsPerClass);
+
+	while (FreeList.Actors.Num() < TargetCount)
+	{
+		// Deferred, so the actor knows it is pooled before its BeginPlay
+		auto* Actor = GetWorld()->SpawnActorDeferred<AActor>(Class, FTransform::Identity);
+
+		if (!IsValid(Actor))
+			return;
+
+		if (auto* Poolable = Cast<IPoolableActor>(Actor))
+			Poolable->OnReleasedToPool();
+
+		Actor->FinishSpawning(FTransform::Identity);
+		SetActorActive(Actor, false);
+		FreeList.Actors.Add(Actor);
+		PooledActors.Add(Actor);
+	}
+}
+
+AActor* UActorPoolSubsystem::AcquireActor(const UObject* WorldContext, UClass* Class, const FTransform& Transform)
+{
+	auto* World = IsValid(WorldContext) ? WorldContext->GetWorld() : nullptr;
+
+	if (!IsValid(World))
+		return nullptr;
+
+	if (auto* Pool = World->GetSubsystem<UActorPoolSubsystem>())
+		return Pool->Acquire(Class, Transform);
+
+	return World->SpawnActor(Class, &Transform);
+}
+
+void UActorPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+		return;
+
+	if (auto* Pool = Actor->GetWorld()->GetSubsystem<UActorPoolSubsystem>())
+		Pool->Release(Actor);
+	else
+		Actor->GetWorld()->DestroyActor(Actor);
+}
+
+void UActorPoolSubsystem::SetActorActive(AActor* Actor, const bool bIsActive)
+{
+	Actor->SetActorHiddenInGame(!bIsActive);
+	Actor->SetActorEnableCollision(bIsActive);
+	Actor->SetActorTickEnabled(bIsActive);
+}
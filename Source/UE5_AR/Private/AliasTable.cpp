@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AliasTable.h"
+
+void FAliasTable::Build(const TArray<float>& Weights)
+{
+	Probability.Reset();
+	Alias.Reset();
+
+	const int32 Count = Weights.Num();
+	float TotalWeight = 0.f;
+
+	for (const float It : Weights)
+		TotalWeight += FMath::Max(It, 0.f);
+
+	if (Count == 0 || TotalWeight <= 0.f)
+		return;
+
+	// Weights scaled so the average column is exactly full
+	TArray<float> Scaled;
+	TArray<int32> Underfull;
+	TArray<int32> Overfull;
+	Scaled.SetNumUninitialized(Count);
+	Probability.SetNumUninitialized(Count);
+	Alias.SetNumUninitialized(Count);
+
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		Scaled[Index] = FMath::Max(Weights[Index], 0.f) * Count / TotalWeight;
+		(Scaled[Index] < 1.f ? Underfull : Overfull).Add(Index);
+	}
+
+	// Every underfull column is topped up by an overfull one, which may become underfull itself
+	while (Underfull.Num() > 0 && Overfull.Num() > 0)
+	{
+		const int32 Small = Underfull.Pop(false);
+		const int32 Large = Overfull.Pop(false);
+
+		Probability[Small] = Scaled[Small];
+		Alias[Small] = Large;
+
+		Scaled[Large] += Scaled[Small] - 1.f;
+		(Scaled[Large] < 1.f ? Underfull : Overfull).Add(Large);
+	}
+
+	// The leftovers are full up to the rounding errors
+	for (const int32 Index : Overfull)
+	{
+		Probability[Index] = 1.f;
+		Alias[Index] = Index;
+	}
+
+	for (const int32 Index : Underfull)
+	{
+		Probability[Index] = 1.f;
+		Alias[Index] = Index;
+	}
+}
+
+int32 FAliasTable::Sample(const float Random) const
+{
+	const int32 Count = Probability.Num();
+
+	if (Count == 0)
+		return INDEX_NONE;
+
+	// The integer part picks the column, the fraction picks the side of its split
+	const float Scaled = FMath::Clamp(Random, 0.f, 1.f) * Count;
+	const int32 Column = FMath::Min(FMath::FloorToInt(Scaled), Count - 1);
+
+	return Scaled - Column < Probability[Column] ? Column : Alias[Column];
+}
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CameraPosePredictor.h"
+
+void FCameraPosePredictor::AddPose(const double Time, const FTransform& CameraTransform)
+{
+	const double DeltaTime = Time - LastTime;
+
+	// Poses of the same moment carry no motion
+	if (bIsValid && DeltaTime <= 0.0)
+		return;
+
+	if (!bIsValid || DeltaTime > ResetTime)
+	{
+		Location = CameraTransform.GetLocation();
+		Rotation = CameraTransform.GetRotation();
+		Velocity = FVector::ZeroVector;
+		AngularVelocity = FVector::ZeroVector;
+		LastTime = Time;
+		bIsValid = true;
+		return;
+	}
+
+	const float Step = static_cast<float>(DeltaTime);
+	FrameInterval += (Step - FrameInterval) * 0.1f;
+	LastTime = Time;
+
+	// Predict the pose of the frame with the velocities
+	const FVector PredictedLocation = Location + Velocity * Step;
+	const FQuat PredictedRotation = FromRotationVector(AngularVelocity * Step) * Rotation;
+
+	// Correct the prediction and the velocities by the part of the tracked pose it missed
+	const FVector LocationResidual = CameraTransform.GetLocation() - PredictedLocation;
+	const FVector RotationResidual = ToRotationVector(CameraTransform.GetRotation() * PredictedRotation.Inverse());
+
+	Location = PredictedLocation + LocationResidual * Alpha;
+	Rotation = FromRotationVector(RotationResidual * Alpha) * PredictedRotation;
+	Rotation.Normalize();
+
+	Velocity += LocationResidual * (Beta / Step);
+	AngularVelocity += RotationResidual * (Beta / Step);
+}
+
+FTransform FCameraPosePredictor::Predict(const double Time) const
+{
+	if (!bIsValid)
+		return FTransform::Identity;
+
+	const float Lead = static_cast<float>(FMath::Clamp(Time - LastTime, 0.0, MaxPredictionTime));
+	auto PredictedRotation = FromRotationVector(AngularVelocity * Lead) * Rotation;
+	PredictedRotation.Normalize();
+
+	return FTransform(PredictedRotation, Location + Velocity * Lead);
+}
+
+FQuat FCameraPosePredictor::FromRotationVector(const FVector& RotationVector)
+{
+	const float Angle = RotationVector.Length();
+
+	if (Angle < KINDA_SMALL_NUMBER)
+		return FQuat::Identity;
+
+	return FQuat(RotationVector / Angle, Angle);
+}
+
+FVector FCameraPosePredictor::ToRotationVector(const FQuat& Rotation)
+{
+	// The shortest way round, a quaternion and its negation are the same rotation
+	FQuat Shortest = Rotation;
+
+	if (Shortest.W < 0.f)
+		Shortest = Shortest * -1.f;
+
+	return Shortest.GetRotationAxis() * Shortest.GetAngle();
+}
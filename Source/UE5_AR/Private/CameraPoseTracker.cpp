@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CameraPoseTracker.h"
+
+void FCameraPoseTracker::Update(const FTransform& CameraTransform)
+{
+	if (!bIsValid)
+	{
+		Pose = CameraTransform;
+		ReferencePose = CameraTransform;
+		FrameLocationDelta = FVector::ZeroVector;
+		FrameRotationDelta = FRotator::ZeroRotator;
+		bHasMovedThisFrame = true;
+		bHasMoved = true;
+		bIsValid = true;
+		return;
+	}
+
+	FrameLocationDelta = CameraTransform.GetLocation() - Pose.GetLocation();
+	FrameRotationDelta = CameraTransform.Rotator() - Pose.Rotator();
+	bHasMovedThisFrame = IsNoticeablyDifferent(CameraTransform, Pose);
+	Pose = CameraTransform;
+
+	bHasMoved = IsNoticeablyDifferent(Pose, ReferencePose);
+
+	if (bHasMoved)
+		ReferencePose = Pose;
+}
+
+bool FCameraPoseTracker::IsNoticeablyDifferent(const FTransform& A, const FTransform& B)
+{
+	if (FVector::DistSquared(A.GetLocation(), B.GetLocation()) > FMath::Square(LocationTolerance))
+		return true;
+
+	return FMath::RadiansToDegrees(A.GetRotation().AngularDistance(B.GetRotation())) > RotationTolerance;
+}
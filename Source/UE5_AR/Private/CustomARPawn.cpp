@@ -37,14 +37,64 @@ void ACustomARPawn::BeginPlay()
 		AudioComponent->SetSound(BgmCue);
 		AudioComponent->Play();
 	}
+
+	// The actors that began play before the player could not find it, camera relative work has to come after the player
+	TArray<AActor*> FoundActors;
+	UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlaceableActor::StaticClass(), FoundActors);
+
+	for (auto* It : FoundActors)
+	{
+		if (IsValid(It))
+			It->AddTickPrerequisiteActor(this);
+	}
+}
+
+void ACustomARPawn::RegisterActorTickFunctions(bool bRegister)
+{
+	Super::RegisterActorTickFunctions(bRegister);
+
+	if (!bRegister)
+	{
+		LateUpdateTick.Unregister();
+		return;
+	}
+
+	LateUpdateTick.Register(this, [this](float)
+	{
+		const auto& RenderedPose = CameraComponent->GetComponentTransform();
+		LateCameraPose.Update(RenderedPose);
+		PosePredictor.AddPose(GetWorld()->GetTimeSeconds(), RenderedPose);
+
+		// The motion is measured on the pose the frame is rendered with, stamped with the time of the same frame
+		if (bIsProcessingMotion)
+			ProcessMotionInput(RenderedPose);
+		else
+			MotionDetector.Reset();
+	});
+}
+
+FTransform ACustomARPawn::GetPredictedCameraPose() const
+{
+	// The last rendered frame is shown the given number of frames later, the horizon is the same whether asked before or after its pose is added
+	const double DisplayTime = PosePredictor.GetLastTime() + CameraPredictionFrames * PosePredictor.GetFrameInterval();
+	return PosePredictor.Predict(DisplayTime);
 }
 
-void ACustomARPawn::OnScreenTouchReleaseMandatory(const ETouchIndex::Type FingerIndex, const FVector ScreenPos)
+void ACustomARPawn::OnTouchInputPressed(const ETouchIndex::Type FingerIndex, const FVector ScreenPos)
 {
-	if (InputTouch == TouchType::Deliberating)
-		OnScreenTouchRelease(FingerIndex, ScreenPos);
+	GestureRecognizer.DragDistance = TouchDragDistance;
+	GestureRecognizer.TapTime = TouchTapTime;
+	ProcessGesture(FingerIndex, GestureRecognizer.OnTouchPressed(FingerIndex, FVector2D(ScreenPos), FPlatformTime::Seconds()));
+}
 
-	InputTouch = TouchType::None;
+void ACustomARPawn::OnTouchInputMoved(const ETouchIndex::Type FingerIndex, const FVector ScreenPos)
+{
+	ProcessGesture(FingerIndex, GestureRecognizer.OnTouchMoved(FingerIndex, FVector2D(ScreenPos), FPlatformTime::Seconds()));
+}
+
+void ACustomARPawn::OnTouchInputReleased(const ETouchIndex::Type FingerIndex, const FVector ScreenPos)
+{
+	ProcessGesture(FingerIndex, GestureRecognizer.OnTouchReleased(FingerIndex, FVector2D(ScreenPos), FPlatformTime::Seconds()));
 }
 
 // Called every frame
@@ -52,14 +102,21 @@ void ACustomARPawn::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Touch Drag Event
-	ProcessTouchInput();
+	CameraPose.Update(CameraComponent->GetComponentTransform());
+
+	// A held finger keeps dragging while the camera moves under it, the drag is traced every frame until release
+	ETouchIndex::Type DragFinger;
+	FVector2D DragPosition;
 
-	if (bIsProcessingMotion)
-		ProcessMotionInput(DeltaTime);
+	if (!bHasPendingDrag && GestureRecognizer.GetDrag(DragFinger, DragPosition))
+		OnScreenDrag(DragFinger, FVector(DragPosition, 0.0f));
 
-	LastCameraPosition = CameraComponent->GetComponentLocation();
-	LastCameraRotation = CameraComponent->GetComponentRotation();
+	// The input of the frame is processed by now, only its latest drag is traced
+	if (bHasPendingDrag)
+	{
+		bHasPendingDrag = false;
+		HandleTouchInput(PendingDragFinger, PendingDragPos, ETouchGesture::Drag);
+	}
 }
 
 // Called to bind functionality to input
@@ -67,8 +124,10 @@ void ACustomARPawn::SetupPlayerInputComponent(UInputComponent* PlayerInputCompon
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
 	
-	//Bind various player inputs to functions
-	PlayerInputComponent->BindTouch(IE_Released, this, &ACustomARPawn::OnScreenTouchReleaseMandatory);
+	//Bind various player inputs to functions, a moving finger repeats its touch
+	PlayerInputComponent->BindTouch(IE_Pressed, this, &ACustomARPawn::OnTouchInputPressed);
+	PlayerInputComponent->BindTouch(IE_Repeat, this, &ACustomARPawn::OnTouchInputMoved);
+	PlayerInputComponent->BindTouch(IE_Released, this, &ACustomARPawn::OnTouchInputReleased);
 }
 
 void ACustomARPawn::OnUIAddNewActorToUI(const TSubclassOf<APlaceableActor> ClassToSpawn)
@@ -77,8 +136,12 @@ void ACustomARPawn::OnUIAddNewActorToUI(const TSubclassOf<APlaceableActor> Class
 	if (!IsValid(GM) || (IsValid(GM->GetGameplayPlane()) && !GM->GetGameplayPlane()->CanAddMeshToUI()))
 		return;
 
-	auto SpawningLocation = CameraComponent->GetComponentLocation();
-	auto* NewActor = Cast<APlaceableActor>(GWorld->SpawnActor(ClassToSpawn, &SpawningLocation));
+	const auto SpawningTransform = FTransform(CameraComponent->GetComponentLocation());
+	auto* NewActor = UActorPoolSubsystem::AcquireActor<APlaceableActor>(this, ClassToSpawn, SpawningTransform);
+
+	if (!IsValid(NewActor))
+		return;
+
 	NewActor->SetAsUIMember(true, this);
 	NewActor->Select();
 }
@@ -95,7 +158,7 @@ void ACustomARPawn::OnUIRemoveSelected()
 	if (UIMembers.Contains(ToRemove))
 		UIMembers.RemoveSingle(ToRemove);
 
-	GWorld->DestroyActor(ToRemove);
+	UActorPoolSubsystem::ReleaseActor(ToRemove);
 }
 
 void ACustomARPawn::OnUISwitchStateTo(const TEnumAsByte<EDisplayMode> NewDisplayMode)
@@ -152,7 +215,7 @@ void ACustomARPawn::OnUISellActualItem(APlaceableActor* ActorToSell)
 
 	const int SellPrice = std::max(1.f,ActorToSell->BuyPrice * ActorToSell->SellPriceDiscount);
 	GM->AddMoney(SellPrice);
-	GWorld->DestroyActor(ActorToSell);
+	UActorPoolSubsystem::ReleaseActor(ActorToSell);
 }
 
 void ACustomARPawn::OnUISetSelectedActorRelativeRotation(const FRotator& Offset)
@@ -312,19 +375,30 @@ void ACustomARPawn::SilenceBGMForSFX(float SilenceTime)
 
 void ACustomARPawn::OnScreenTouchRelease(const ETouchIndex::Type FingerIndex, const FVector &ScreenPos)
 {
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("Screen Touch Reached"));
-	InputTouch = TouchType::Press;
-	HandleTouchInput(FingerIndex, ScreenPos);
+	HandleTouchInput(FingerIndex, ScreenPos, ETouchGesture::Tap);
 }
 
 void ACustomARPawn::OnScreenDrag(const ETouchIndex::Type FingerIndex, const FVector &ScreenPos)
 {
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("Screen Drag Reached"));
-	InputTouch = TouchType::Drag;
-	HandleTouchInput(FingerIndex, ScreenPos);
+	PendingDragFinger = FingerIndex;
+	PendingDragPos = ScreenPos;
+	bHasPendingDrag = true;
 }
 
-void ACustomARPawn::OnSuddenMovement(const FVector& MovementDelta)
+void ACustomARPawn::OnScreenPinch(const float Scale, const float Rotation)
+{
+	const auto GM = Cast<ACustomGameMode>(GetWorld()->GetAuthGameMode());
+
+	if (!IsValid(GM) || GM->GetDisplayType() == EDisplayMode::Intro || !IsValid(GM->GetSelectedActor()))
+		return;
+
+	// The pinch scales in proportion to the current size, the UI functions take offsets
+	const auto CurrentScale = GM->GetSelectedActor()->StaticMeshComponent->GetComponentScale();
+	OnUISetSelectedActorRelativeScale(CurrentScale * (Scale - 1.f));
+	OnUISetSelectedActorRelativeRotation(FRotator(0.f, Rotation, 0.f));
+}
+
+void ACustomARPawn::OnSuddenMovement(const FVector& MovementVelocity)
 {
 	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("Sudden Movement"));
 	TArray<AActor*> FoundActors;
@@ -334,8 +408,8 @@ void ACustomARPawn::OnSuddenMovement(const FVector& MovementDelta)
 	{
 		auto* FoundActor = IsValid(It) ? Cast<APlaceableActor>(It) : nullptr;
 
-		if (IsValid(FoundActor))
-			FoundActor->OnSuddenPlayerMove(MovementDelta);
+		if (IsValid(FoundActor) && !FoundActor->IsInPool() && !FoundActor->IsSuspended())
+			FoundActor->OnSuddenPlayerMove(MovementVelocity);
 	}
 }
 
@@ -349,45 +423,49 @@ void ACustomARPawn::OnSuddenRotation(const FRotator& RotationDelta)
 	{
 		auto* FoundActor = IsValid(It) ? Cast<APlaceableActor>(It) : nullptr;
 
-		if (IsValid(FoundActor))
+		if (IsValid(FoundActor) && !FoundActor->IsInPool() && !FoundActor->IsSuspended())
 			FoundActor->OnSuddenPlayerRotate(RotationDelta);
 	}
 }
 
-void ACustomARPawn::HandleTouchInput(const ETouchIndex::Type FingerIndex, const FVector &ScreenPos)
+void ACustomARPawn::HandleTouchInput(const ETouchIndex::Type FingerIndex, const FVector &ScreenPos, const ETouchGesture::Type Gesture)
 {
 	const auto GM = Cast<ACustomGameMode>(GetWorld()->GetAuthGameMode());
 
 	if (!IsValid(GM) || GM->GetDisplayType() == EDisplayMode::Intro)
 		return;
 
-	TArray<FARTraceResult> ARHits;
-	FHitResult HitResult;
-	FVector HitDirection;
-	GM->AskForLineTrace(ScreenPos, ARHits, HitResult, HitDirection);
+	GM->AskForAsyncLineTrace(ScreenPos, FOnTouchTraceDone::CreateUObject(this, &ACustomARPawn::OnTouchTraceDone, FingerIndex, Gesture));
+}
+
+void ACustomARPawn::OnTouchTraceDone(const TArray<FARTraceResult>& ARHits, const FHitResult& HitResult, const FVector& HitDirection, const ETouchIndex::Type FingerIndex, const ETouchGesture::Type Gesture)
+{
+	const auto GM = Cast<ACustomGameMode>(GetWorld()->GetAuthGameMode());
+
+	// The mode could have changed while the trace was running
+	if (!IsValid(GM) || GM->GetDisplayType() == EDisplayMode::Intro)
+		return;
 
 	if (HitResult.IsValidBlockingHit())
 	{
-		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("Game Object touched"));
 		auto* HitObject = IsValid(HitResult.GetActor()) ? Cast<APlaceableActor>(HitResult.GetActor()) : nullptr;
 
 		if (IsValid(HitObject))
 		{
-			switch(InputTouch)
+			switch(Gesture)
 			{
-				case TouchType::Press:
+				case ETouchGesture::Tap:
 					HitObject->OnTouched(HitResult.ImpactPoint);
 					break;
 
-				case TouchType::Drag:
+				case ETouchGesture::Drag:
 					HitObject->OnDrag(HitResult.ImpactPoint);
 					break;
+
+				default:
+					break;
 			}
 		}
-		else
-		{
-			GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("Failed Cast To APlaceableActor"));
-		}
 	}
 	else
 	{
@@ -398,43 +476,38 @@ void ACustomARPawn::HandleTouchInput(const ETouchIndex::Type FingerIndex, const
 	}
 }
 
-void ACustomARPawn::ProcessTouchInput()
+void ACustomARPawn::ProcessGesture(const ETouchIndex::Type FingerIndex, const FTouchGesture& Gesture)
 {
-	if (const auto* PlayerController = Cast<APlayerController>(GetController()))
+	const FVector ScreenPos = FVector(Gesture.Position, 0.0f);
+
+	switch (Gesture.Type)
 	{
-		float LocX, LocY;
-		bool bIsPressed;
-		PlayerController->GetInputTouchState(ETouchIndex::Type::Touch1, LocX, LocY, bIsPressed);
+		case ETouchGesture::Tap:
+			OnScreenTouchRelease(FingerIndex, ScreenPos);
+			break;
 
-		if (bIsPressed)
-		{
-			if (InputTouch == TouchType::None)
-			{
-				TouchTimestamp = FDateTime::Now();
-				InputTouch = TouchType::Deliberating;
-			}
+		case ETouchGesture::Drag:
+			OnScreenDrag(FingerIndex, ScreenPos);
+			break;
 
-			const int DeltaTicks = FDateTime::Now().GetTicks() - TouchTimestamp.GetTicks();
+		case ETouchGesture::Pinch:
+			OnScreenPinch(Gesture.Scale, Gesture.Rotation);
+			break;
 
-			if (DeltaTicks > HoldFrames)
-			{
-				const FVector CurrentTouchLocation = FVector(LocX, LocY, 0.0f);
-				OnScreenDrag(ETouchIndex::Type::Touch1, CurrentTouchLocation);
-			}
-		}
+		default:
+			break;
 	}
 }
 
-void ACustomARPawn::ProcessMotionInput(const float DeltaTime)
+void ACustomARPawn::ProcessMotionInput(const FTransform& RenderedPose)
 {
-	// Possible optimization oof combining the loops within the functions
-	const auto PositionDelta = CameraComponent->GetComponentLocation() - LastCameraPosition;
-
-	if (PositionDelta.Length() > MovementMotionSensitivity * DeltaTime)
-		OnSuddenMovement(PositionDelta);
+	// The detector works on timestamps, the same jerk is detected the same at any frame rate
+	MotionDetector.SetThresholds(MovementMotionSensitivity, RotationMotionSensitivity);
+	MotionDetector.AddPose(GetWorld()->GetTimeSeconds(), RenderedPose);
 
-	const auto RotationDelta = CameraComponent->GetComponentRotation() - LastCameraRotation;
+	if (MotionDetector.HasSuddenMovement())
+		OnSuddenMovement(MotionDetector.GetVelocity());
 
-	if ((RotationDelta.Pitch + RotationDelta.Yaw + RotationDelta.Roll) * DeltaTime > RotationMotionSensitivity)
-		OnSuddenRotation(RotationDelta);
+	if (MotionDetector.HasSuddenRotation())
+		OnSuddenRotation(MotionDetector.GetWindowRotation());
 }
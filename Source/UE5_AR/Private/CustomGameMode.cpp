@@ -13,6 +13,7 @@
 #include "Camera/CameraComponent.h"
 #include "CustomUserWidget.h"
 #include "FishingPond.h"
+#include "SfxSubsystem.h"
 #include "Sound/SoundBase.h"
 
 ACustomGameMode::ACustomGameMode() :
@@ -28,21 +29,116 @@ ACustomGameMode::ACustomGameMode() :
 
 void ACustomGameMode::AskForLineTrace(const FVector &ScreenPos, TArray<FARTraceResult>& TraceResults, FHitResult& TraceResultObj, FVector& DirectionResult)
 {
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("Line Trace Reached"));
+	FCollisionQueryParams QueryParams;
+	auto Trace = MakeTouchTrace(FVector2D(ScreenPos), QueryParams);
 
-	//Basic variables for functionality
-	const APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
-	FVector WorldPos;
-
-	//Gets the screen touch in world space and the tracked objects from a line trace from the touch
-	UGameplayStatics::DeprojectScreenToWorld(PlayerController, FVector2D(ScreenPos), WorldPos, DirectionResult);
 	// Notice that this AskForLineTrace is in the ARBluePrintLibrary - this means that it's exclusive only for objects tracked by ARKit/ARCore
-	TraceResults = UARBlueprintLibrary::LineTraceTrackedObjects(FVector2D(ScreenPos), false, false, false, true);
+	TraceResults = UARBlueprintLibrary::LineTraceTrackedObjects(Trace.ScreenPos, false, false, false, true);
+
 	// Line trace used for getting objects within the engine
+	const bool bHitActor = GetWorld()->LineTraceSingleByChannel(Trace.HitResult, Trace.Start, Trace.End, ECollisionChannel::ECC_Pawn, QueryParams);
+	FinishTouchTrace(Trace, bHitActor);
+
+	TraceResultObj = Trace.HitResult;
+	DirectionResult = Trace.Direction;
+}
+
+void ACustomGameMode::AskForAsyncLineTrace(const FVector& ScreenPos, const FOnTouchTraceDone& OnDone)
+{
+	if (!TouchTraceDelegate.IsBound())
+		TouchTraceDelegate.BindUObject(this, &ACustomGameMode::OnAsyncTouchTraceDone);
+
+	FCollisionQueryParams QueryParams;
+	auto Trace = MakeTouchTrace(FVector2D(ScreenPos), QueryParams);
+	Trace.OnDone = OnDone;
+	Trace.Handle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Trace.Start, Trace.End, ECollisionChannel::ECC_Pawn,
+		QueryParams, FCollisionResponseParams::DefaultResponseParam, &TouchTraceDelegate);
+
+	PendingTouchTraces.Add(MoveTemp(Trace));
+}
+
+ACustomGameMode::FTouchTrace ACustomGameMode::MakeTouchTrace(const FVector2D& ScreenPos, FCollisionQueryParams& OutQueryParams) const
+{
+	FTouchTrace Trace;
+	Trace.ScreenPos = ScreenPos;
+
+	//Gets the screen touch in world space
+	const APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+	UGameplayStatics::DeprojectScreenToWorld(PlayerController, ScreenPos, Trace.Start, Trace.Direction);
+
+	// The gameplay plane is intersected exactly, the physics only has to find the objects in front of it
+	Trace.bEndsOnPlane = IsValid(SpawnedPlane)
+		&& SpawnedPlane->CanIntersectRay()
+		&& SpawnedPlane->IntersectRay(Trace.Start, Trace.Direction, ObjectLineTraceDistance, Trace.End);
+
+	if (Trace.bEndsOnPlane)
+		OutQueryParams.AddIgnoredActor(SpawnedPlane);
+	else
+		Trace.End = Trace.Start + (Trace.Direction * ObjectLineTraceDistance);
+
+	return Trace;
+}
+
+void ACustomGameMode::FinishTouchTrace(FTouchTrace& Trace, const bool bHitActor) const
+{
+	if (bHitActor || !Trace.bEndsOnPlane || !IsValid(SpawnedPlane))
+		return;
+
+	Trace.HitResult = FHitResult(SpawnedPlane, SpawnedPlane->StaticMeshComponent, Trace.End, SpawnedPlane->StaticMeshComponent->GetUpVector());
+	Trace.HitResult.bBlockingHit = true;
+	Trace.HitResult.TraceStart = Trace.Start;
+	Trace.HitResult.TraceEnd = Trace.End;
+	Trace.HitResult.Distance = FVector::Distance(Trace.Start, Trace.End);
+}
+
+void ACustomGameMode::OnAsyncTouchTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	auto* Trace = PendingTouchTraces.FindByPredicate([&Handle](const FTouchTrace& It) { return It.Handle == Handle; });
+
+	if (Trace == nullptr)
+		return;
+
+	const bool bHitActor = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit;
+
+	if (bHitActor)
+		Trace->HitResult = Datum.OutHits[0];
 
-	const FVector WorldEnd = WorldPos + (DirectionResult * ObjectLineTraceDistance);
-	GWorld->LineTraceSingleByChannel(TraceResultObj, WorldPos, WorldEnd, ECollisionChannel::ECC_Pawn);
-};
+	FinishTouchTrace(*Trace, bHitActor);
+	Trace->bIsDone = true;
+}
+
+void ACustomGameMode::ProcessTouchTraces()
+{
+	TArray<FTouchTrace> DoneTraces;
+
+	for (int32 Index = PendingTouchTraces.Num() - 1; Index >= 0; Index--)
+	{
+		if (!PendingTouchTraces[Index].bIsDone)
+			continue;
+
+		DoneTraces.Insert(MoveTemp(PendingTouchTraces[Index]), 0);
+		PendingTouchTraces.RemoveAt(Index, 1, false);
+	}
+
+	// Traced together after the physics, only for the touches that hit no actor and once per screen position
+	TArray<TPair<FVector2D, TArray<FARTraceResult>>> ARHits;
+	const TArray<FARTraceResult> NoARHits;
+
+	for (const auto& It : DoneTraces)
+	{
+		if (It.HitResult.IsValidBlockingHit() || ARHits.ContainsByPredicate([&It](const auto& Hits) { return Hits.Key == It.ScreenPos; }))
+			continue;
+
+		ARHits.Emplace(It.ScreenPos, UARBlueprintLibrary::LineTraceTrackedObjects(It.ScreenPos, false, false, false, true));
+	}
+
+	// The delegates may start new traces, they are only added to the pending ones
+	for (const auto& It : DoneTraces)
+	{
+		const auto* Hits = It.HitResult.IsValidBlockingHit() ? nullptr : ARHits.FindByPredicate([&It](const auto& Hits) { return Hits.Key == It.ScreenPos; });
+		It.OnDone.ExecuteIfBound(Hits != nullptr ? Hits->Value : NoARHits, It.HitResult, It.Direction);
+	}
+}
 
 void ACustomGameMode::StartPlay() 
 {
@@ -85,19 +181,28 @@ void ACustomGameMode::AddMoney(const int32 AddMoney)
 
 void ACustomGameMode::SetDisplayType(const TEnumAsByte<EDisplayMode> NewMode)
 {
+	const auto PreviousMode = DisplayType;
 	DisplayType = NewMode;
 	TArray<AActor*> FoundActors;
+	TArray<APlaceableActor*> ActiveActors;
 	UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlaceableActor::StaticClass(), FoundActors);
 
 	for (auto* It : FoundActors)
 	{
 		auto* FoundActor = IsValid(It) ? Cast<APlaceableActor>(It) : nullptr;
 
-		if (IsValid(FoundActor))
-			FoundActor->OnDisplayModeChanged(NewMode);
+		if (IsValid(FoundActor) && !FoundActor->IsInPool() && !FoundActor->IsSuspended())
+			ActiveActors.Add(FoundActor);
 	}
 
-	if (IsValid(ArManager))
+	// The scene being left is kept as it is, only the actors that cannot wait in it are told about the new mode, all of them when it is not kept
+	if (PreviousMode != NewMode)
+		SuspendScene(PreviousMode, ActiveActors);
+
+	for (auto* It : ActiveActors)
+		It->OnDisplayModeChanged(NewMode);
+
+	if ((PreviousMode == NewMode || !ResumeScene(NewMode)) && IsValid(ArManager))
 		ArManager->ContinueTrackingAllPlanes();
 
 	if (IsValid(CurrentUI))
@@ -113,6 +218,168 @@ void ACustomGameMode::SetDisplayType(const TEnumAsByte<EDisplayMode> NewMode)
 	CurrentUI->AddToViewport();
 }
 
+bool ACustomGameMode::SuspendScene(const TEnumAsByte<EDisplayMode> Mode, TArray<APlaceableActor*>& Actors)
+{
+	if (!bSuspendScenes || MaxSuspendedScenes <= 0 || SuspendedScenesBudgetKB <= 0 || !IsValid(SpawnedPlane) || !SpawnedPlane->CanBeSuspended())
+		return false;
+
+	// An older scene of the same mode could never be shown again
+	EvictScene(Mode);
+
+	// The scene is measured before anything is suspended, a scene that does not fit is closed as without suspension
+	TArray<APlaceableActor*> SceneActors;
+	int64 SceneSize = EstimateActorSize(SpawnedPlane);
+
+	for (auto* It : Actors)
+	{
+		if (It == SpawnedPlane || !It->CanBeSuspended())
+			continue;
+
+		SceneActors.Add(It);
+		SceneSize += EstimateActorSize(It);
+	}
+
+	if (SceneSize > static_cast<int64>(SuspendedScenesBudgetKB) * 1024)
+		return false;
+
+	// Over the cap or the budget, the least recently shown scenes make room
+	while (SuspendedScenes.Num() > 0 && !FitsSuspendedScenesBudget(SceneSize))
+	{
+		auto OldestMode = Mode;
+		float OldestTime = TNumericLimits<float>::Max();
+
+		for (const auto& It : SuspendedScenes)
+		{
+			if (It.Value.LastShownTime < OldestTime)
+			{
+				OldestMode = It.Key;
+				OldestTime = It.Value.LastShownTime;
+			}
+		}
+
+		EvictScene(OldestMode);
+	}
+
+	FSuspendedScene Scene;
+	Scene.Plane = SpawnedPlane;
+	Scene.LastShownTime = GetWorld()->GetTimeSeconds();
+	Scene.EstimatedSize = SceneSize;
+
+	SpawnedPlane->Suspend();
+	Actors.RemoveSingleSwap(SpawnedPlane);
+
+	for (auto* It : SceneActors)
+	{
+		It->Suspend();
+		Scene.Actors.Add(It);
+		Actors.RemoveSingleSwap(It);
+	}
+
+	SuspendedScenes.Add(Mode, Scene);
+	SetSelectedActor(nullptr);
+	SpawnedPlane = nullptr;
+	bPlaneDetermined = false;
+
+	return true;
+}
+
+bool ACustomGameMode::ResumeScene(const TEnumAsByte<EDisplayMode> Mode)
+{
+	auto* Scene = SuspendedScenes.Find(Mode);
+
+	if (Scene == nullptr)
+		return false;
+
+	if (!IsValid(Scene->Plane))
+	{
+		EvictScene(Mode);
+		return false;
+	}
+
+	FSuspendedScene ResumedScene;
+	SuspendedScenes.RemoveAndCopyValue(Mode, ResumedScene);
+
+	SpawnedPlane = ResumedScene.Plane;
+	SpawnedPlane->Resume();
+	bPlaneDetermined = true;
+
+	for (auto* It : ResumedScene.Actors)
+	{
+		if (IsValid(It))
+			It->Resume();
+	}
+
+	// Only the plane the scene is pinned to is tracked, as when the scene was spawned
+	auto* PinnedPlane = IsValid(SpawnedPlane->PinComponent) ?
+		Cast<UARPlaneGeometry>(SpawnedPlane->PinComponent->GetTrackedGeometry()) :
+		nullptr;
+
+	if (IsValid(ArManager))
+	{
+		if (IsValid(PinnedPlane))
+			ArManager->StopTrackingPlanesExcept(PinnedPlane);
+		else
+			ArManager->ContinueTrackingAllPlanes();
+	}
+
+	auto* Player = Cast<ACustomARPawn>(UGameplayStatics::GetPlayerPawn(this, 0));
+
+	if (IsValid(Player))
+		Player->SwitchBgm(DisplayType);
+
+	return true;
+}
+
+void ACustomGameMode::EvictScene(const TEnumAsByte<EDisplayMode> Mode)
+{
+	FSuspendedScene Scene;
+
+	if (!SuspendedScenes.RemoveAndCopyValue(Mode, Scene))
+		return;
+
+	// The plane goes first, the pond releases the fish it simulates on its own
+	if (IsValid(Scene.Plane))
+		Scene.Plane->Destroy();
+
+	for (auto* It : Scene.Actors)
+	{
+		if (IsValid(It) && !It->IsInPool())
+			UActorPoolSubsystem::ReleaseActor(It);
+	}
+}
+
+bool ACustomGameMode::FitsSuspendedScenesBudget(const int64 AddedSize) const
+{
+	if (SuspendedScenes.Num() + 1 > MaxSuspendedScenes)
+		return false;
+
+	int64 TotalSize = AddedSize;
+
+	for (const auto& It : SuspendedScenes)
+		TotalSize += It.Value.EstimatedSize;
+
+	return TotalSize <= static_cast<int64>(SuspendedScenesBudgetKB) * 1024;
+}
+
+int64 ACustomGameMode::EstimateActorSize(AActor* Actor)
+{
+	if (!IsValid(Actor))
+		return 0;
+
+	// Only the memory of the instances counts, the shared assets stay loaded anyway
+	FResourceSizeEx Size(EResourceSizeMode::Exclusive);
+	Size.AddDedicatedSystemMemoryBytes(Actor->GetClass()->GetStructureSize());
+	Actor->GetResourceSizeEx(Size);
+
+	for (auto* Component : TInlineComponentArray<UActorComponent*>(Actor))
+	{
+		Size.AddDedicatedSystemMemoryBytes(Component->GetClass()->GetStructureSize());
+		Component->GetResourceSizeEx(Size);
+	}
+
+	return static_cast<int64>(Size.GetTotalMemoryBytes());
+}
+
 void ACustomGameMode::SetSelectedActor(APlaceableActor* SelectedObj)
 {
 	// Second condition is needed in case we have deselected object manually beforehand...
@@ -130,6 +397,9 @@ void ACustomGameMode::Tick(float DeltaSeconds)
 
 	if (!IsValid(SpawnedPlane))
 		bPlaneDetermined = false;
+
+	// The physics traces of the touches started last frame are done by now
+	ProcessTouchTraces();
 }
 
 void ACustomGameMode::StartGame()
@@ -200,7 +470,7 @@ void ACustomGameMode::AskForLineTraceSpawnActor(const FARTraceResult &LineTraceH
 				ActorPin->AddToRoot();
 
 				if (IsValid(PlaneSpawnSfx))
-					UGameplayStatics::PlaySoundAtLocation(this, PlaneSpawnSfx, MyLoc);
+					USfxSubsystem::PlaySoundAtLocation(this, PlaneSpawnSfx, MyLoc);
 
 				// DisplayType enum -> int32
 				if (IsValid(Player))
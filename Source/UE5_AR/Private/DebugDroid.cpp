@@ -14,17 +14,33 @@ void ADebugDroid::Tick(float DeltaTime)
 
 	if (IsValid(PinComponent) && PinComponent->GetTrackingState() == EARTrackingState::Tracking)
 	{
-		// Camera Distance gathering
-		double DistanceFromCamera = 0.0f;
-		if (const auto* Player = dynamic_cast<ACustomARPawn*>(GWorld->GetFirstPlayerController()->GetPawn()))
-			DistanceFromCamera = UKismetMathLibrary::Vector4_Size(GetActorLocation() - Player->CameraComponent->GetComponentLocation());
-		else
+		const auto* Player = dynamic_cast<ACustomARPawn*>(GWorld->GetFirstPlayerController()->GetPawn());
+
+		if (!Player)
+		{
 			GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("Failed Cast to Player (APlaceableActor::Tick())"));
+			return;
+		}
+
+		// Nothing to measure again while neither the droid nor the camera moved
+		const auto Location = GetActorLocation();
+
+		if (bIsColourSet && !Player->GetCameraPose().HasMoved() && Location.Equals(MeasuredLocation, FCameraPoseTracker::LocationTolerance))
+			return;
+
+		// Camera Distance gathering
+		const double DistanceFromCamera = UKismetMathLibrary::Vector4_Size(Location - Player->GetCameraPose().GetPose().GetLocation());
+		const bool bIsCloseNow = DistanceFromCamera <= MaxDistance;
+		MeasuredLocation = Location;
+
+		// Changing colour based on the distance, only when it changes
+		if (bIsColourSet && bIsCloseNow == bIsClose)
+			return;
+
+		bIsClose = bIsCloseNow;
+		bIsColourSet = IsValid(ActualMaterial);
 
-		// Changing colour based on the distance
-		if (DistanceFromCamera > MaxDistance)
-			ActualMaterial->SetVectorParameterValue("BaseColor", FarColour);
-		else
-			ActualMaterial->SetVectorParameterValue("BaseColor", CloseColour);
+		if (bIsColourSet)
+			ActualMaterial->SetVectorParameterValue("BaseColor", bIsClose ? CloseColour : FarColour);
 	}
 }
@@ -5,6 +5,9 @@
 #include "CustomARPawn.h"
 #include "FishingPond.h"
 #include "FishingLure.h"
+#include "FishSpeciesData.h"
+#include "HapticsSubsystem.h"
+#include "SfxSubsystem.h"
 #include "Camera/CameraComponent.h"
 #include "CustomUserWidget.h"
 #include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
@@ -19,91 +22,56 @@ AFish::AFish()
 	RealFishMeshComponent->SetupAttachment(RootComponent);
 	RealFishMeshComponent->SetVisibility(false);
 	RealFishMeshComponent->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
+	RealFishMeshComponent->SetGenerateOverlapEvents(false);
 
+	// Traces still hit the fish, the lure detection is done by the pond
 	StaticMeshComponent->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
-
-	SwimmingCollider = CreateDefaultSubobject<USphereComponent>(TEXT("SwimmingCollider"));
-	SwimmingCollider->SetupAttachment(RootComponent);
-	SwimmingCollider->OnComponentBeginOverlap.AddDynamic(this, &AFish::OnColliderEnter);
-	SwimmingCollider->OnComponentEndOverlap.AddDynamic(this, &AFish::OnColliderLeave);
-
-	RelativeTransform.SetScale3D(FVector(ScaleWidth,  ScaleHeight,  1));
+	StaticMeshComponent->SetGenerateOverlapEvents(false);
 }
 
 void AFish::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (IsValid(FishMesh) && IsValid(FishMesh->GetMaterial(0)))
-		FishActualMaterial = UMaterialInstanceDynamic::Create(FishMesh->GetMaterial(0), NULL);
-
-	if (IsValid(StaticMeshComponent))
-		StaticMeshComponent->SetWorldScale3D(FVector(ScaleHeight, ScaleWidth, 1.f));
+	// Pooled fish get their species from the pond once acquired
+	if (IsValid(Species))
+		SetSpecies(Species);
 }
 
 void AFish::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// Merged with the requests of the other fish and the pond into one update per frame
 	if (IsValid(LureInVicinity))
-	{
-		auto* Player = UGameplayStatics::GetPlayerController(this, 0);
-		if (IsValid(Player))
-		{
-			UGameplayStatics::GetPlayerController(this, 0)->PlayDynamicForceFeedback(
-				0.3,
-				0.1,
-				true,
-				true,
-				true,
-				true,
-				EDynamicForceFeedbackAction::Start
-			);
-		}
-	}
-	
+		UHapticsSubsystem::RequestForceFeedback(this, 0.3f, EHapticPriority::Interaction);
+
+	// Swimming fish are updated by the pond, the actor only ticks once it leaves the simulation
 	switch(State)
 	{
-		case Entering:
-			if (MockCoro_FadeInAnimation(DeltaTime))
-			{
-				State = Swimming;
-			}
-		case Swimming:
-			MoveTowardsInterest(DeltaTime);
-			MockCoro_ConsiderChangingTarget(DeltaTime);
-			if (Iterations > IterationLifespan)
-				State = Leaving;
+		case EFishState::Escaped:
+			if (!bAnimateInMaterials)
+				OpacityTimeline.WriteValueTo(ActualMaterial, "OpacityFactor", GetWorld()->GetTimeSeconds());
 
-			break;
-
-		case Leaving:
-			MoveTowardsInterest(DeltaTime);
-		case Escaped:
-			if (MockCoro_FadeOutAnimation(DeltaTime))
+			if (OpacityTimeline.IsFinished(GetWorld()->GetTimeSeconds()))
 			{
-				const auto* GM = Cast<ACustomGameMode>(GetWorld()->GetAuthGameMode());
-				auto* Pond = IsValid(GM) ? Cast<AFishingPond>(GM->GetGameplayPlane()) : nullptr;
-
-				if (IsValid(Pond))
-					Pond->RemoveFish(this);
+				if (IsValid(OwningPond))
+					OwningPond->RemoveFish(this);
 
-				GWorld->DestroyActor(this);
+				UActorPoolSubsystem::ReleaseActor(this);
 			}
 
 			return;
 
-		case ReelingIn:
+		case EFishState::ReelingIn:
 			if (ShouldEscape())
-				State = Escaped;
+				Escape();
 			else if (MockCoro_ReelInAnimation(DeltaTime))
 			{
-				State = Caught;
-				const auto* GM = Cast<ACustomGameMode>(GetWorld()->GetAuthGameMode());
-				auto* Pond = IsValid(GM) ? Cast<AFishingPond>(GM->GetGameplayPlane()) : nullptr;
+				State = EFishState::Caught;
 
-				if (IsValid(Pond))
-						Pond->RemoveFish(this);
+				if (IsValid(OwningPond))
+					OwningPond->RemoveFish(this);
 
 				if (IsValid(LureInVicinity))
 				{
@@ -112,37 +80,44 @@ void AFish::Tick(float DeltaTime)
 			}
 
 			break;
+
+		default:
+			break;
 	}
 }
 
 void AFish::OnTouched(const FVector& TouchPositionWorld)
 {
-	if (State == Caught)
+	if (GetFishState() == EFishState::Caught)
 		Super::OnTouched(TouchPositionWorld);
 }
 
 void AFish::OnDisplayModeChanged(const TEnumAsByte<EDisplayMode> NewMode)
 {
+	if (IsInSwarm())
+	{
+		OwningPond->GetSwarm().LeavePond(SwarmIndex);
+		return;
+	}
+
 	switch (State)
 	{
-		case ReelingIn:
-			State = Escaped;
+		case EFishState::ReelingIn:
+			Escape();
 			break;
 
-		case Caught:
-			GWorld->DestroyActor(this);
+		case EFishState::Caught:
+			UActorPoolSubsystem::ReleaseActor(this);
 			return;
 
 		default:
-			State = Leaving;
+			break;
 	}
 }
 
-void AFish::OnSuddenPlayerMove(const FVector& MovementDelta)
+void AFish::OnSuddenPlayerMove(const FVector& MovementVelocity)
 {
-	const float DeltaTime = UGameplayStatics::GetWorldDeltaSeconds(this);
-
-	if (State < Interactive)
+	if (GetFishState() < EFishState::Interactive)
 	{
 		const auto Player = Cast<ACustomARPawn>(UGameplayStatics::GetPlayerPawn(this, 0));
 
@@ -152,7 +127,7 @@ void AFish::OnSuddenPlayerMove(const FVector& MovementDelta)
 		if (IsValid(LureInVicinity) 
 			&& LureInVicinity->IsDesirable()
 			&& !LureInVicinity->IsCatchingFish()
-			&& MovementDelta.Length() < (CatchingMovementRangeTop) * DeltaTime)
+			&& MovementVelocity.Length() < (IsValid(Species) ? Species->CatchingMovementRangeTop : 0.f))
 		{
 			LureInVicinity->SetIsCatchingFish(true);
 			Catch();
@@ -166,141 +141,118 @@ void AFish::OnSuddenPlayerMove(const FVector& MovementDelta)
 
 void AFish::OnSuddenPlayerRotate(const FRotator& RotationDelta)
 {
-	if (State == ReelingIn)
+	if (GetFishState() == EFishState::ReelingIn)
 		GuaranteeEscape = true;
 }
 
-void AFish::OnColliderEnter(
-	UPrimitiveComponent* OverlappedComp, 
-	AActor* OtherActor, 
-	UPrimitiveComponent* OtherComp, 
-	int32 OtherBodyIndex, 
-	bool bFromSweep, 
-	const FHitResult& SweepResult)
+void AFish::OnReleasedToPool()
 {
-	auto* PotentialLure = Cast<AFishingLure>(OtherActor);
-
-	if (IsValid(PotentialLure))
-	{
-		if (PotentialLure->IsSpooky())
-		{
-			SpookFish(PotentialLure->GetActorLocation());
-			return;
-		}
-
-		LureInVicinity = PotentialLure;
-	}
-}
-
-void AFish::OnColliderLeave(
-	UPrimitiveComponent* OverlappedComp,
-	AActor* OtherActor,
-	UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex)
-{
-	const auto* PotentialLure = Cast<AFishingLure>(OtherActor);
-
-	//Reeling in requires lure for the movement strength value
-	if (IsValid(PotentialLure) 
-		&& LureInVicinity == PotentialLure
-		&& State != ReelingIn)
-		LureInVicinity = nullptr;
+	Super::OnReleasedToPool();
+
+	State = EFishState::Entering;
+	SwarmIndex = INDEX_NONE;
+	OwningPond = nullptr;
+	LureInVicinity = nullptr;
+	GuaranteeEscape = false;
+	MockCoro_ReelInAnimation_FirstRun = true;
+	RealFishMeshComponent->SetVisibility(false);
+	SetOpacityTimeline(FMaterialTimeline(0.f, 0.f, 1.f, 1.f));
 }
 
 void AFish::LeavePond()
 {
-	if (State < Interactive)
-		State = Leaving;
+	if (IsInSwarm())
+		OwningPond->GetSwarm().LeavePond(SwarmIndex);
+	else if (State < EFishState::Interactive)
+		State = EFishState::Leaving;
 }
 
 void AFish::Catch()
 {
-	if (State != Leaving && State < Interactive)
-		State = ReelingIn;
+	const auto CurrentState = GetFishState();
+
+	if (CurrentState != EFishState::Leaving && CurrentState < EFishState::Interactive)
+	{
+		// The actor takes over from the pond simulation for the reel in
+		if (IsInSwarm())
+			OwningPond->DetachFish(this);
+
+		State = EFishState::ReelingIn;
+	}
 
 	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Blue, FString::Printf(TEXT("Caught!")));
 
-	if (IsValid(SplashSfx))
-		UGameplayStatics::PlaySoundAtLocation(this, SplashSfx, GetActorLocation(), GetActorRotation());
+	if (IsValid(Species) && IsValid(Species->SplashSfx))
+		USfxSubsystem::PlaySoundAtLocation(this, Species->SplashSfx, GetActorLocation());
 }
 
 void AFish::SpookFish(const FVector& WorldSpookSource)
 {
-	if (State >= Interactive || State == Leaving)
+	// Only swimming fish can be spooked
+	if (!IsInSwarm())
 		return;
 
-	State = Leaving;
-	Speed *= 10;
-	MaxAngularVelocity = 180;
-
-	auto RelativeSpookSource = PinComponent->GetLocalToWorldTransform().GetLocation() - WorldSpookSource;
-	RelativeSpookSource.Z = 0;
+	const auto RelativeSpookSource = OwningPond->GetPondTransform().InverseTransformPosition(WorldSpookSource);
 
-	const auto RelativeDirectionToSpookSource = RelativeSpookSource - RelativeTransform.GetLocation();
-	RelativePointOfInterest = RelativeTransform.GetLocation() + (RelativeDirectionToSpookSource * -1) * 150;
+	if (!OwningPond->SpookSwarmFish(SwarmIndex, RelativeSpookSource))
+		return;
 
-	if (IsValid(SplashSfx))
-		UGameplayStatics::PlaySoundAtLocation(this, SplashSfx, GetActorLocation(), GetActorRotation());
+	if (IsValid(Species) && IsValid(Species->SplashSfx))
+		USfxSubsystem::PlaySoundAtLocation(this, Species->SplashSfx, GetActorLocation());
 }
 
 bool AFish::ShouldNotRemoveFromWorld() const
 {
-	return State == Escaped || State == Leaving || State == Caught;
+	const auto CurrentState = GetFishState();
+	return CurrentState == EFishState::Escaped || CurrentState == EFishState::Leaving || CurrentState == EFishState::Caught;
 }
 
-void AFish::MoveTowardsInterest(const float DeltaTime)
+bool AFish::IsInSwarm() const
 {
-	if (!IsValid(PinComponent))
-		return;
-
-	auto RelativeForward = RelativeTransform.GetRotation().GetForwardVector();
-	RelativeForward.Normalize();
-
-	auto RelativePosition = RelativeTransform.GetLocation();
-	RelativePosition += RelativeForward * Speed * DeltaTime;
-	RelativeTransform.SetLocation(RelativePosition);
-	RelativePosition.Z = 0.0f;
-	ActualAngularVelocity = MaxAngularVelocity * FMath::RandRange(0.5f, 1.f);
-
-	auto RelativeDirectionToInterest = RelativePointOfInterest - RelativePosition;
-
-	if (State == Swimming)
-		Speed = FMath::Min(RelativeDirectionToInterest.Length(), MaxSpeed);
+	return SwarmIndex != INDEX_NONE && IsValid(OwningPond);
+}
 
-	RelativeDirectionToInterest.Normalize();
+EFishState::Type AFish::GetFishState() const
+{
+	if (IsInSwarm())
+		return static_cast<EFishState::Type>(OwningPond->GetSwarm().State[SwarmIndex]);
 
-	float RelativeAngleToInterest = acosf(RelativeForward.Dot(RelativeDirectionToInterest));
-	RelativeAngleToInterest *= 180 / PI;
+	return State;
+}
 
-	int ClockwiseDirection = 0;
+void AFish::SetSpecies(UFishSpeciesData* InSpecies)
+{
+	if (!IsValid(InSpecies))
+		return;
 
-	if (RelativeForward.Y > 0)
-	{
-		if (RelativeDirectionToInterest.Y > 0)
-			ClockwiseDirection = RelativeForward.X > RelativeDirectionToInterest.X ? 1 : -1;
-		else
-			ClockwiseDirection = RelativeForward.X > RelativeDirectionToInterest.X * -1 ? -1 : 1;
-	}
-	else
+	// A pooled fish reused for the same species keeps its material
+	if (InSpecies != Species || !IsValid(FishActualMaterial))
 	{
-		if (RelativeDirectionToInterest.Y <= 0)
-			ClockwiseDirection = RelativeForward.X > RelativeDirectionToInterest.X ? -1 : 1;
-		else
-			ClockwiseDirection = RelativeForward.X > RelativeDirectionToInterest.X * -1 ? 1 : -1;
+		FishActualMaterial = IsValid(InSpecies->FishMesh) && IsValid(InSpecies->FishMesh->GetMaterial(0)) ?
+			UMaterialInstanceDynamic::Create(InSpecies->FishMesh->GetMaterial(0), this) :
+			nullptr;
 	}
 
-	RelativeAngleToInterest = floor(RelativeAngleToInterest);
+	Species = InSpecies;
 
-	if (abs(RelativeAngleToInterest) < 2)
-		return;
+	if (IsValid(StaticMeshComponent))
+	{
+		StaticMeshComponent->SetWorldScale3D(FVector(Species->ScaleHeight, Species->ScaleWidth, 1.f));
+		InitialMeshTransform = StaticMeshComponent->GetRelativeTransform();
+	}
+}
 
-	RelativeTransform.SetRotation(
-		FRotator(
-			0, 
-			RelativeTransform.GetRotation().Rotator().Yaw + fminf(abs(RelativeAngleToInterest), ActualAngularVelocity) * DeltaTime * ClockwiseDirection,
-			0).Quaternion());
+void AFish::UpdateFromSwarm(const FTransform& SwarmRelativeTransform, const FTransform& PondTransform)
+{
+	RelativeTransform.SetLocation(SwarmRelativeTransform.GetLocation());
+	RelativeTransform.SetRotation(SwarmRelativeTransform.GetRotation());
+	SetActorTransform(RelativeTransform * PondTransform);
+}
 
-	MockCoro_WiggleAnimation(DeltaTime);
+void AFish::ShowOwnSilhouette(const float Opacity)
+{
+	StaticMeshComponent->SetVisibility(true);
+	SetOpacityTimeline(FMaterialTimeline(GetWorld()->GetTimeSeconds(), 0.f, Opacity, Opacity));
 }
 
 bool AFish::ShouldEscape()
@@ -311,70 +263,26 @@ bool AFish::ShouldEscape()
 	return false;
 }
 
-void AFish::MockCoro_ConsiderChangingTarget(const float DeltaTime)
-{
-	MockCoro_ConsiderChangingTarget_Timer += DeltaTime;
-
-	if (MockCoro_ConsiderChangingTarget_Timer > TargetChangeTime 
-		|| FVector(RelativePointOfInterest - RelativeTransform.GetLocation()).Length() < 1.f)
-	{
-		int RandomValue = FMath::RandRange(1, 100);
-		Iterations++;
-		MockCoro_ConsiderChangingTarget_Timer = 0;
-
-		FVector RelativeLureLocation;
-		const auto GM = Cast<ACustomGameMode>(GetWorld()->GetAuthGameMode());
-		const auto Pond = (IsValid(GM) && IsValid(GM->GetGameplayPlane())) ?
-			Cast<AFishingPond>(GM->GetGameplayPlane()) :
-			nullptr;
-
-		if (IsValid(Pond) 
-			&& Pond->GetValidLureRelativeLocation(RelativeLureLocation)
-			&& FVector(RelativeTransform.GetLocation() - RelativeLureLocation).Length() < LureDetectionRadius
-			&& RandomValue <= ChoosingLureProbability)
-		{
-			RelativePointOfInterest = RelativeLureLocation;
-			return;
-		}
-
-		RelativePointOfInterest = FVector(FMath::RandRange(-100, 100), FMath::RandRange(-100, 100), 0);
-	}
-}
-
-bool AFish::MockCoro_FadeInAnimation(const float DeltaTime)
+void AFish::Escape()
 {
-	if (MockCoro_FadeInAnimation_CurrentOpacity < 1.f)
-	{
-		MockCoro_FadeInAnimation_CurrentOpacity += DeltaTime * FadeInOutSpeed;
-
-		if (MockCoro_FadeInAnimation_CurrentOpacity > 0.9f)
-			MockCoro_FadeInAnimation_CurrentOpacity = 0.9f;
-
-		if (IsValid(ActualMaterial))
-			ActualMaterial->SetScalarParameterValue("OpacityFactor", MockCoro_FadeInAnimation_CurrentOpacity);
+	State = EFishState::Escaped;
 
-		return false;
-	}
+	// Fades from wherever the opacity is, the material takes it from here when it can
+	const float Time = GetWorld()->GetTimeSeconds();
+	const float CurrentOpacity = OpacityTimeline.Evaluate(Time);
+	const float FadeOutSpeed = (IsValid(Species) ? Species->FadeInOutSpeed : 1.f) * 2;
 
-	return true;
+	SetOpacityTimeline(FMaterialTimeline(Time, CurrentOpacity / FMath::Max(FadeOutSpeed, KINDA_SMALL_NUMBER), CurrentOpacity, 0.f));
 }
 
-bool AFish::MockCoro_FadeOutAnimation(const float DeltaTime)
+void AFish::SetOpacityTimeline(const FMaterialTimeline& InOpacityTimeline)
 {
-	if (MockCoro_FadeOutAnimation_CurrentOpacity > 0.f)
-	{
-		MockCoro_FadeOutAnimation_CurrentOpacity -= DeltaTime * FadeInOutSpeed * 2;
+	OpacityTimeline = InOpacityTimeline;
 
-		if (MockCoro_FadeOutAnimation_CurrentOpacity < 0.f)
-			MockCoro_FadeOutAnimation_CurrentOpacity = 0.f;
-
-		if (IsValid(ActualMaterial))
-			ActualMaterial->SetScalarParameterValue("OpacityFactor", MockCoro_FadeOutAnimation_CurrentOpacity);
-
-		return false;
-	}
-
-	return true;
+	if (bAnimateInMaterials)
+		OpacityTimeline.WriteTo(ActualMaterial, "OpacityFactor");
+	else
+		OpacityTimeline.WriteValueTo(ActualMaterial, "OpacityFactor", OpacityTimeline.StartTime);
 }
 
 bool AFish::MockCoro_ReelInAnimation(const float DeltaTime)
@@ -384,7 +292,8 @@ bool AFish::MockCoro_ReelInAnimation(const float DeltaTime)
 	if (!IsValid(Player))
 		return false;
 
-	const auto CameraPosition = Player->CameraComponent->GetComponentLocation();
+	// Homing to where the camera is when the frame is shown, not where it was last frame
+	const auto CameraPosition = Player->GetPredictedCameraPose().GetLocation();
 
 	if (MockCoro_ReelInAnimation_FirstRun)
 	{
@@ -392,6 +301,7 @@ bool AFish::MockCoro_ReelInAnimation(const float DeltaTime)
 		RealFishMeshComponent->SetVisibility(true);
 		StaticMeshComponent->SetVisibility(false);
 		ActualMaterial = FishActualMaterial;
+		SetOpacityTimeline(OpacityTimeline);
 		MockCoro_ReelInAnimation_FirstRun = false;
 	}
 	
@@ -406,21 +316,16 @@ bool AFish::MockCoro_ReelInAnimation(const float DeltaTime)
 
 	if (FVector(CameraPosition - WorldActorLocation).Length() <= SnappingDistance)
 	{
-		const auto GM = Cast<ACustomGameMode>(GetWorld()->GetAuthGameMode());
-		const auto Pond = (IsValid(GM) && IsValid(GM->GetGameplayPlane())) ?
-			Cast<AFishingPond>(GM->GetGameplayPlane()) :
-			nullptr;
-
-		if (IsValid(Pond) && Player->QuantityInTempInventory() < Pond->MaxCaughtFishCapacity)
+		if (IsValid(OwningPond) && Player->QuantityInTempInventory() < OwningPond->MaxCaughtFishCapacity)
 		{
 			WorldActorLocation.Z = 5000;
 			SetARPosition(WorldActorLocation);
 			Player->AddNewToTempInventory(this);
 
-			if (IsValid(CaughtSfx))
+			if (IsValid(Species) && IsValid(Species->CaughtSfx))
 			{
 				Player->SilenceBGMForSFX();
-				UGameplayStatics::PlaySoundAtLocation(this, CaughtSfx, GetActorLocation(), GetActorRotation(), 0.6);
+				USfxSubsystem::PlaySoundAtLocation(this, Species->CaughtSfx, CameraPosition, 0.6f);
 			}
 
 			return true;
@@ -436,10 +341,3 @@ bool AFish::MockCoro_ReelInAnimation(const float DeltaTime)
 	return false;
 }
 
-void AFish::MockCoro_WiggleAnimation(const float DeltaTime)
-{
-	MockCoro_WiggleAnimation_SineInput += DeltaTime * WiggleSpeedFactor;
-
-	float YawOffset = sinf(MockCoro_WiggleAnimation_SineInput) * MaxWiggleAngle;
-	StaticMeshComponent->SetRelativeRotation(FRotator(0, YawOffset, 0));
-}
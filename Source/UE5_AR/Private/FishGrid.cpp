@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FishGrid.h"
+
+void FFishGrid::Build(const TArray<float>& PositionX, const TArray<float>& PositionY, const float InCellSize)
+{
+	const int32 Count = PositionX.Num();
+
+	if (Count == 0 || InCellSize <= 0.f)
+	{
+		Reset();
+		return;
+	}
+
+	// Bounds of the fish, the grid only covers the occupied area
+	float MinX = PositionX[0], MaxX = PositionX[0];
+	float MinY = PositionY[0], MaxY = PositionY[0];
+
+	for (int32 Index = 1; Index < Count; Index++)
+	{
+		MinX = FMath::Min(MinX, PositionX[Index]);
+		MaxX = FMath::Max(MaxX, PositionX[Index]);
+		MinY = FMath::Min(MinY, PositionY[Index]);
+		MaxY = FMath::Max(MaxY, PositionY[Index]);
+	}
+
+	OriginX = MinX;
+	OriginY = MinY;
+
+	// Cells grow when the fish spread too far apart for the cell limit
+	const float CellSize = FMath::Max3(InCellSize, (MaxX - MinX) / (MaxCellsPerAxis - 1), (MaxY - MinY) / (MaxCellsPerAxis - 1));
+	InverseCellSize = 1.f / CellSize;
+	CellsX = CellCoordinate(MaxX, OriginX) + 1;
+	CellsY = CellCoordinate(MaxY, OriginY) + 1;
+
+	// Counting sort of the positions by cell
+	CellStart.Reset();
+	CellStart.SetNumZeroed(CellsX * CellsY + 1);
+	CellOfIndex.SetNumUninitialized(Count, false);
+
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		const int32 CellX = FMath::Clamp(CellCoordinate(PositionX[Index], OriginX), 0, CellsX - 1);
+		const int32 CellY = FMath::Clamp(CellCoordinate(PositionY[Index], OriginY), 0, CellsY - 1);
+		CellOfIndex[Index] = CellY * CellsX + CellX;
+		CellStart[CellOfIndex[Index] + 1]++;
+	}
+
+	for (int32 Cell = 1; Cell < CellStart.Num(); Cell++)
+		CellStart[Cell] += CellStart[Cell - 1];
+
+	SortedIndices.SetNumUninitialized(Count, false);
+	SortedX.SetNumUninitialized(Count, false);
+	SortedY.SetNumUninitialized(Count, false);
+
+	// Cell starts are used as insertion cursors and restored afterwards
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		const int32 Slot = CellStart[CellOfIndex[Index]]++;
+		SortedIndices[Slot] = Index;
+		SortedX[Slot] = PositionX[Index];
+		SortedY[Slot] = PositionY[Index];
+	}
+
+	for (int32 Cell = CellStart.Num() - 1; Cell > 0; Cell--)
+		CellStart[Cell] = CellStart[Cell - 1];
+
+	CellStart[0] = 0;
+}
+
+void FFishGrid::Reset()
+{
+	CellStart.Reset();
+	CellOfIndex.Reset();
+	SortedIndices.Reset();
+	SortedX.Reset();
+	SortedY.Reset();
+	CellsX = 0;
+	CellsY = 0;
+}
+
+void FFishGrid::QueryRadius(const float X, const float Y, const float Radius, TArray<int32>& OutIndices) const
+{
+	ForEachInRadius(X, Y, Radius, [&OutIndices](const int32 Index, const float)
+	{
+		OutIndices.Add(Index);
+	});
+}
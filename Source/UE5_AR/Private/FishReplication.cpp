@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FishReplication.h"
+#include "FishingPond.h"
+#include "FishSwarm.h"
+
+static_assert(FFishSwarm::TargetExtent <= FReplicatedFish::PositionExtent, "The fish targets have to be within the replicated range.");
+
+void FReplicatedFish::Write(const FFishSwarm& Swarm, const int32 Index)
+{
+	Id = Swarm.NetId[Index];
+	Species = Swarm.Species[Index];
+	State = Swarm.State[Index];
+	X = QuantizePosition(Swarm.PositionX[Index]);
+	Y = QuantizePosition(Swarm.PositionY[Index]);
+	TargetX = QuantizePosition(Swarm.TargetX[Index]);
+	TargetY = QuantizePosition(Swarm.TargetY[Index]);
+	Yaw = static_cast<uint8>(FMath::RoundToInt(FRotator::ClampAxis(Swarm.Yaw[Index]) * 256.f / 360.f) & 0xFF);
+	Speed = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Swarm.Speed[Index]), 0, 255));
+	Age = 0.f;
+}
+
+void FReplicatedFish::Read(FFishSwarm& Swarm, const int32 Index) const
+{
+	Swarm.State[Index] = State;
+	Swarm.PositionX[Index] = DequantizePosition(X);
+	Swarm.PositionY[Index] = DequantizePosition(Y);
+	Swarm.Yaw[Index] = FRotator::NormalizeAxis(Yaw * 360.f / 256.f);
+	Swarm.Speed[Index] = Speed;
+
+	// Fish joining after the fade in are already visible
+	if (State != EFishState::Entering && Swarm.Opacity[Index] <= 0.f)
+		Swarm.Opacity[Index] = 0.9f;
+
+	Swarm.Retarget(Index, DequantizePosition(TargetX), DequantizePosition(TargetY));
+}
+
+bool FReplicatedFish::HasDiverged(const FFishSwarm& Swarm, const int32 Index, const float Tolerance) const
+{
+	if (Swarm.State[Index] != State || Swarm.Species[Index] != Species)
+		return true;
+
+	// Compared as sent, a target outside the range would never match the sent one
+	const float DriftX = DequantizePosition(QuantizePosition(Swarm.TargetX[Index])) - DequantizePosition(TargetX);
+	const float DriftY = DequantizePosition(QuantizePosition(Swarm.TargetY[Index])) - DequantizePosition(TargetY);
+	return DriftX * DriftX + DriftY * DriftY > Tolerance * Tolerance;
+}
+
+bool FReplicatedFish::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	if (Ar.IsLoading())
+		State = 0;
+
+	Ar << Id;
+	Ar << Species;
+	Ar.SerializeBits(&State, 3);
+	Ar << X;
+	Ar << Y;
+	Ar << TargetX;
+	Ar << TargetY;
+	Ar << Yaw;
+	Ar << Speed;
+
+	bOutSuccess = true;
+	return true;
+}
+
+void FReplicatedFish::PostReplicatedAdd(const FReplicatedFishArray& InArraySerializer)
+{
+	if (IsValid(InArraySerializer.Pond))
+		InArraySerializer.Pond->OnReplicatedFishChanged(*this);
+}
+
+void FReplicatedFish::PostReplicatedChange(const FReplicatedFishArray& InArraySerializer)
+{
+	if (IsValid(InArraySerializer.Pond))
+		InArraySerializer.Pond->OnReplicatedFishChanged(*this);
+}
+
+void FReplicatedFish::PreReplicatedRemove(const FReplicatedFishArray& InArraySerializer)
+{
+	if (IsValid(InArraySerializer.Pond))
+		InArraySerializer.Pond->OnReplicatedFishRemoved(*this);
+}
+
+int16 FReplicatedFish::QuantizePosition(const float Value)
+{
+	return static_cast<int16>(FMath::RoundToInt(FMath::Clamp(Value, -PositionExtent, PositionExtent) * PositionScale));
+}
+
+float FReplicatedFish::DequantizePosition(const int16 Value)
+{
+	return Value / PositionScale;
+}
+
+FReplicatedFish* FReplicatedFishArray::Find(const uint16 Id)
+{
+	return Items.FindByPredicate([Id](const FReplicatedFish& It) { return It.Id == Id; });
+}
+
+void FReplicatedFishArray::Remove(const uint16 Id)
+{
+	const int32 Index = Items.IndexOfByPredicate([Id](const FReplicatedFish& It) { return It.Id == Id; });
+
+	if (Index == INDEX_NONE)
+		return;
+
+	Items.RemoveAtSwap(Index);
+	MarkArrayDirty();
+}
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FishSpeciesData.h"
+#include "Fish.h"
+
+FFishSwarmParams UFishSpeciesData::MakeSwarmParams() const
+{
+	FFishSwarmParams Params;
+	Params.FadeInOutSpeed = FadeInOutSpeed;
+	Params.MaxWiggleAngle = MaxWiggleAngle;
+	Params.WiggleSpeedFactor = WiggleSpeedFactor;
+	Params.MaxSpeed = MaxSpeed;
+	Params.MaxAngularVelocity = MaxAngularVelocity;
+	Params.TargetChangeTime = TargetChangeTime;
+	Params.LureDetectionRadius = LureDetectionRadius;
+	Params.ChoosingLureProbability = ChoosingLureProbability;
+	Params.IterationLifespan = IterationLifespan;
+	return Params;
+}
+
+UFishSpeciesData* UFishSpeciesData::CreateFromFishClass(UObject* Outer, const TSubclassOf<AFish> InFishClass)
+{
+	const auto* Defaults = IsValid(InFishClass) ? InFishClass->GetDefaultObject<AFish>() : nullptr;
+
+	if (!IsValid(Defaults))
+		return nullptr;
+
+	auto* Species = NewObject<UFishSpeciesData>(Outer, NAME_None, RF_Transient);
+	Species->FishClass = InFishClass;
+	Species->FishMesh = Defaults->FishMesh;
+	Species->SplashSfx = Defaults->SplashSfx;
+	Species->CaughtSfx = Defaults->CaughtSfx;
+	Species->FadeInOutSpeed = Defaults->FadeInOutSpeed;
+	Species->ScaleWidth = Defaults->ScaleWidth;
+	Species->ScaleHeight = Defaults->ScaleHeight;
+	Species->MaxWiggleAngle = Defaults->MaxWiggleAngle;
+	Species->WiggleSpeedFactor = Defaults->WiggleSpeedFactor;
+	Species->MaxSpeed = Defaults->MaxSpeed;
+	Species->MaxAngularVelocity = Defaults->MaxAngularVelocity;
+	Species->CatchingMovementRangeTop = Defaults->CatchingMovementRangeTop;
+	Species->TargetChangeTime = Defaults->TargetChangeTime;
+	Species->ChoosingLureProbability = Defaults->ChoosingLureProbability;
+	Species->LureDetectionRadius = Defaults->LureDetectionRadius;
+	Species->IterationLifespan = Defaults->IterationLifespan;
+	return Species;
+}
@@ -0,0 +1,643 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FishSwarm.h"
+#include "FishGrid.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	//! Number of fish updated by one parallel task, a multiple of the steering kernel width
+	constexpr int32 FishPerChunk = 64;
+
+	//! @brief Advances a xorshift32 generator
+	//! @param State - [IN/OUT] Non zero generator state.
+	//! @returns [0,1) - Uniform random value.
+	float NextRandom(uint32& State)
+	{
+		State ^= State << 13;
+		State ^= State >> 17;
+		State ^= State << 5;
+		return (State >> 8) * (1.f / 16777216.f);
+	}
+}
+
+int32 FFishSwarm::Add(const FVector& RelativePosition, const FVector& PointOfInterest, const uint8 InSpecies)
+{
+	check(SpeciesParams.IsValidIndex(InSpecies));
+
+	const FFishSwarmParams& InParams = SpeciesParams[InSpecies];
+	const int32 Index = State.Num();
+
+	PositionX.Add(RelativePosition.X);
+	PositionY.Add(RelativePosition.Y);
+	PositionZ.Add(RelativePosition.Z);
+	Yaw.Add(0.f);
+	PreviousPositionX.Add(RelativePosition.X);
+	PreviousPositionY.Add(RelativePosition.Y);
+	PreviousYaw.Add(0.f);
+	Speed.Add(20.f);
+	MaxAngularVelocity.Add(InParams.MaxAngularVelocity);
+	MaxSpeed.Add(InParams.MaxSpeed);
+	TargetX.Add(PointOfInterest.X);
+	TargetY.Add(PointOfInterest.Y);
+	TargetChangeTimer.Add(0.f);
+	Opacity.Add(0.f);
+	WiggleSineInput.Add(0.f);
+	WiggleYaw.Add(0.f);
+	WiggleSpeedFactor.Add(InParams.WiggleSpeedFactor);
+	MaxWiggleAngle.Add(InParams.MaxWiggleAngle);
+	RandomState.Add(static_cast<uint32>(FMath::Rand()) | 1u);
+	State.Add(EFishState::Entering);
+	Iterations.Add(0);
+	Species.Add(InSpecies);
+	NetId.Add(0);
+	Significance.Add(EFishSignificance::High);
+	PendingTime.Add(0.f);
+	PathDistance.AddZeroed();
+	PathLength.AddZeroed();
+	PathStartYaw.AddZeroed();
+	ArcCenterX.AddZeroed();
+	ArcCenterY.AddZeroed();
+	ArcRadius.AddZeroed();
+	ArcStartAngle.AddZeroed();
+	ArcCurvature.AddZeroed();
+	ArcLength.AddZeroed();
+	LineStartX.AddZeroed();
+	LineStartY.AddZeroed();
+	LineDirectionX.AddZeroed();
+	LineDirectionY.AddZeroed();
+	LineYaw.AddZeroed();
+
+	PlanPath(Index);
+
+	return Index;
+}
+
+void FFishSwarm::RemoveAtSwap(const int32 Index)
+{
+	PositionX.RemoveAtSwap(Index, 1, false);
+	PositionY.RemoveAtSwap(Index, 1, false);
+	PositionZ.RemoveAtSwap(Index, 1, false);
+	Yaw.RemoveAtSwap(Index, 1, false);
+	PreviousPositionX.RemoveAtSwap(Index, 1, false);
+	PreviousPositionY.RemoveAtSwap(Index, 1, false);
+	PreviousYaw.RemoveAtSwap(Index, 1, false);
+	Speed.RemoveAtSwap(Index, 1, false);
+	MaxAngularVelocity.RemoveAtSwap(Index, 1, false);
+	MaxSpeed.RemoveAtSwap(Index, 1, false);
+	TargetX.RemoveAtSwap(Index, 1, false);
+	TargetY.RemoveAtSwap(Index, 1, false);
+	TargetChangeTimer.RemoveAtSwap(Index, 1, false);
+	Opacity.RemoveAtSwap(Index, 1, false);
+	WiggleSineInput.RemoveAtSwap(Index, 1, false);
+	WiggleYaw.RemoveAtSwap(Index, 1, false);
+	WiggleSpeedFactor.RemoveAtSwap(Index, 1, false);
+	MaxWiggleAngle.RemoveAtSwap(Index, 1, false);
+	RandomState.RemoveAtSwap(Index, 1, false);
+	State.RemoveAtSwap(Index, 1, false);
+	Iterations.RemoveAtSwap(Index, 1, false);
+	Species.RemoveAtSwap(Index, 1, false);
+	NetId.RemoveAtSwap(Index, 1, false);
+	Significance.RemoveAtSwap(Index, 1, false);
+	PendingTime.RemoveAtSwap(Index, 1, false);
+	PathDistance.RemoveAtSwap(Index, 1, false);
+	PathLength.RemoveAtSwap(Index, 1, false);
+	PathStartYaw.RemoveAtSwap(Index, 1, false);
+	ArcCenterX.RemoveAtSwap(Index, 1, false);
+	ArcCenterY.RemoveAtSwap(Index, 1, false);
+	ArcRadius.RemoveAtSwap(Index, 1, false);
+	ArcStartAngle.RemoveAtSwap(Index, 1, false);
+	ArcCurvature.RemoveAtSwap(Index, 1, false);
+	ArcLength.RemoveAtSwap(Index, 1, false);
+	LineStartX.RemoveAtSwap(Index, 1, false);
+	LineStartY.RemoveAtSwap(Index, 1, false);
+	LineDirectionX.RemoveAtSwap(Index, 1, false);
+	LineDirectionY.RemoveAtSwap(Index, 1, false);
+	LineYaw.RemoveAtSwap(Index, 1, false);
+}
+
+void FFishSwarm::Empty()
+{
+	PositionX.Reset();
+	PositionY.Reset();
+	PositionZ.Reset();
+	Yaw.Reset();
+	PreviousPositionX.Reset();
+	PreviousPositionY.Reset();
+	PreviousYaw.Reset();
+	Speed.Reset();
+	MaxAngularVelocity.Reset();
+	MaxSpeed.Reset();
+	TargetX.Reset();
+	TargetY.Reset();
+	TargetChangeTimer.Reset();
+	Opacity.Reset();
+	WiggleSineInput.Reset();
+	WiggleYaw.Reset();
+	WiggleSpeedFactor.Reset();
+	MaxWiggleAngle.Reset();
+	RandomState.Reset();
+	State.Reset();
+	Iterations.Reset();
+	Species.Reset();
+	NetId.Reset();
+	Significance.Reset();
+	PendingTime.Reset();
+	PathDistance.Reset();
+	PathLength.Reset();
+	PathStartYaw.Reset();
+	ArcCenterX.Reset();
+	ArcCenterY.Reset();
+	ArcRadius.Reset();
+	ArcStartAngle.Reset();
+	ArcCurvature.Reset();
+	ArcLength.Reset();
+	LineStartX.Reset();
+	LineStartY.Reset();
+	LineDirectionX.Reset();
+	LineDirectionY.Reset();
+	LineYaw.Reset();
+}
+
+void FFishSwarm::Update(const float DeltaTime, const FVector* LureRelativeLocation, TArray<int32>& OutFinished)
+{
+	const int32 Count = Num();
+
+	StepTime.SetNumUninitialized(Count, false);
+	FinishedFlags.Reset();
+	FinishedFlags.SetNumZeroed(Count);
+
+	// Each fish only touches its own slots, the chunks run on the task graph workers
+	const int32 ChunkCount = FMath::DivideAndRoundUp(Count, FishPerChunk);
+
+	ParallelFor(ChunkCount, [this, Count, DeltaTime, LureRelativeLocation](const int32 Chunk)
+	{
+		const int32 First = Chunk * FishPerChunk;
+		UpdateRange(First, FMath::Min(First + FishPerChunk, Count), DeltaTime, LureRelativeLocation);
+	}, ChunkCount < 2);
+
+	UpdateCounter++;
+
+	// Results the owner has to act on are gathered once the workers are done
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		if (FinishedFlags[Index])
+			OutFinished.Add(Index);
+	}
+}
+
+void FFishSwarm::ApplyAvoidance(const FFishGrid& Grid, const float Radius, const float Strength, const float DeltaTime)
+{
+	const int32 Count = Num();
+
+	if (Count < 2 || Radius <= 0.f || Strength <= 0.f)
+		return;
+
+	AvoidanceX.Reset();
+	AvoidanceY.Reset();
+	AvoidanceX.SetNumZeroed(Count);
+	AvoidanceY.SetNumZeroed(Count);
+
+	// Pushes are gathered first, the result does not depend on the order of the fish so the chunks run in parallel
+	const int32 ChunkCount = FMath::DivideAndRoundUp(Count, FishPerChunk);
+
+	ParallelFor(ChunkCount, [this, &Grid, Count, Radius](const int32 Chunk)
+	{
+		const int32 First = Chunk * FishPerChunk;
+		const int32 Last = FMath::Min(First + FishPerChunk, Count);
+
+		for (int32 Index = First; Index < Last; Index++)
+		{
+			Grid.ForEachInRadius(PositionX[Index], PositionY[Index], Radius, [this, Index, Radius](const int32 Neighbour, const float DistanceSquared)
+			{
+				if (Neighbour == Index || DistanceSquared < SMALL_NUMBER)
+					return;
+
+				const float Distance = FMath::Sqrt(DistanceSquared);
+				const float Weight = (Radius - Distance) / (Radius * Distance);
+				AvoidanceX[Index] += (PositionX[Index] - PositionX[Neighbour]) * Weight;
+				AvoidanceY[Index] += (PositionY[Index] - PositionY[Neighbour]) * Weight;
+			});
+		}
+	}, ChunkCount < 2);
+
+	const float Step = Strength * DeltaTime;
+
+	// The whole path moves with the fish, the positions are evaluated from it
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		const float PushX = AvoidanceX[Index] * Step;
+		const float PushY = AvoidanceY[Index] * Step;
+
+		PositionX[Index] += PushX;
+		PositionY[Index] += PushY;
+		ArcCenterX[Index] += PushX;
+		ArcCenterY[Index] += PushY;
+		LineStartX[Index] += PushX;
+		LineStartY[Index] += PushY;
+		TargetX[Index] += PushX;
+		TargetY[Index] += PushY;
+	}
+}
+
+void FFishSwarm::LeavePond(const int32 Index)
+{
+	if (State[Index] < EFishState::Interactive)
+		State[Index] = EFishState::Leaving;
+}
+
+bool FFishSwarm::Spook(const int32 Index, const FVector& RelativeSpookSource)
+{
+	if (State[Index] >= EFishState::Interactive || State[Index] == EFishState::Leaving)
+		return false;
+
+	State[Index] = EFishState::Leaving;
+	Speed[Index] *= 10;
+	MaxAngularVelocity[Index] = 180;
+
+	// Swim the opposite way from the source, the target is cut short at the extent so the replicas plan the same path
+	const float AwayX = PositionX[Index] - RelativeSpookSource.X;
+	const float AwayY = PositionY[Index] - RelativeSpookSource.Y;
+	float Reach = 150.f;
+
+	if (!FMath::IsNearlyZero(AwayX))
+		Reach = FMath::Min(Reach, ((AwayX > 0.f ? TargetExtent : -TargetExtent) - PositionX[Index]) / AwayX);
+
+	if (!FMath::IsNearlyZero(AwayY))
+		Reach = FMath::Min(Reach, ((AwayY > 0.f ? TargetExtent : -TargetExtent) - PositionY[Index]) / AwayY);
+
+	Reach = FMath::Max(Reach, 0.f);
+	TargetX[Index] = FMath::Clamp(PositionX[Index] + AwayX * Reach, -TargetExtent, TargetExtent);
+	TargetY[Index] = FMath::Clamp(PositionY[Index] + AwayY * Reach, -TargetExtent, TargetExtent);
+	PlanPath(Index);
+	return true;
+}
+
+void FFishSwarm::Retarget(const int32 Index, const float InTargetX, const float InTargetY)
+{
+	TargetX[Index] = InTargetX;
+	TargetY[Index] = InTargetY;
+	TargetChangeTimer[Index] = 0.f;
+	PlanPath(Index);
+}
+
+FTransform FFishSwarm::GetRelativeTransform(const int32 Index) const
+{
+	return FTransform(
+		FRotator(0, Yaw[Index], 0),
+		FVector(PositionX[Index], PositionY[Index], PositionZ[Index])
+	);
+}
+
+void FFishSwarm::StorePreviousState()
+{
+	PreviousPositionX = PositionX;
+	PreviousPositionY = PositionY;
+	PreviousYaw = Yaw;
+}
+
+FTransform FFishSwarm::GetInterpolatedRelativeTransform(const int32 Index, const float Alpha, const float StepTime) const
+{
+	// The path is analytic, a fish waiting for its step is drawn where the gathered time would take it
+	if (Significance[Index] == EFishSignificance::Low)
+	{
+		float Distance = PathDistance[Index] + Speed[Index] * (PendingTime[Index] + Alpha * StepTime);
+
+		// A swimming fish slows down to stop at its point of interest
+		if (State[Index] == EFishState::Swimming)
+			Distance = FMath::Min(Distance, FMath::Max(PathLength[Index], PathDistance[Index]));
+
+		float X, Y, PathYaw;
+		EvaluatePath(Index, Distance, X, Y, PathYaw);
+		return FTransform(FRotator(0, PathYaw, 0), FVector(X, Y, PositionZ[Index]));
+	}
+
+	const float YawDelta = FRotator::NormalizeAxis(Yaw[Index] - PreviousYaw[Index]);
+
+	return FTransform(
+		FRotator(0, PreviousYaw[Index] + YawDelta * Alpha, 0),
+		FVector(
+			FMath::Lerp(PreviousPositionX[Index], PositionX[Index], Alpha),
+			FMath::Lerp(PreviousPositionY[Index], PositionY[Index], Alpha),
+			PositionZ[Index]
+		)
+	);
+}
+
+void FFishSwarm::UpdateRange(const int32 First, const int32 Last, const float DeltaTime, const FVector* LureRelativeLocation)
+{
+	const int32 Interval = FMath::Max(LowSignificanceInterval, 1);
+
+	// Low significance fish gather the time and take one longer step when due, staggered by index to spread the load
+	for (int32 Index = First; Index < Last; Index++)
+	{
+		PendingTime[Index] += DeltaTime;
+
+		const bool bIsDue = Significance[Index] == EFishSignificance::High || (UpdateCounter + Index) % Interval == 0;
+		StepTime[Index] = bIsDue ? PendingTime[Index] : 0.f;
+
+		// A fish catching up on gathered time was drawn ahead of its state, the step is interpolated from there
+		if (bIsDue && PendingTime[Index] > DeltaTime)
+			EvaluatePath(Index, PathDistance[Index] + Speed[Index] * (PendingTime[Index] - DeltaTime), PreviousPositionX[Index], PreviousPositionY[Index], PreviousYaw[Index]);
+
+		if (bIsDue)
+			PendingTime[Index] = 0.f;
+	}
+
+	// Every due fish swims, four at a time through the kernel and the rest one by one
+	const int32 BatchedLast = First + ((Last - First) & ~3);
+
+	for (int32 Index = First; Index < BatchedLast; Index += 4)
+		MoveTowardsInterestBatch(Index);
+
+	for (int32 Index = BatchedLast; Index < Last; Index++)
+	{
+		if (StepTime[Index] > 0.f)
+			MoveTowardsInterest(Index, StepTime[Index]);
+	}
+
+	for (int32 Index = First; Index < Last; Index++)
+	{
+		const float FishDeltaTime = StepTime[Index];
+
+		if (FishDeltaTime <= 0.f)
+			continue;
+
+		// A replica only animates the opacity, the decisions arrive with the remote state
+		if (bIsReplica)
+		{
+			if (State[Index] == EFishState::Entering)
+				FadeIn(Index, FishDeltaTime);
+			else if (State[Index] == EFishState::Leaving)
+				FadeOut(Index, FishDeltaTime);
+
+			continue;
+		}
+
+		switch (State[Index])
+		{
+			case EFishState::Entering:
+				if (FadeIn(Index, FishDeltaTime))
+				{
+					State[Index] = EFishState::Swimming;
+				}
+			case EFishState::Swimming:
+				ConsiderChangingTarget(Index, FishDeltaTime, LureRelativeLocation);
+				if (Iterations[Index] > GetParams(Index).IterationLifespan)
+					State[Index] = EFishState::Leaving;
+
+				break;
+
+			case EFishState::Leaving:
+				if (FadeOut(Index, FishDeltaTime))
+					FinishedFlags[Index] = 1;
+
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+void FFishSwarm::PlanPath(const int32 Index)
+{
+	const float StartX = PositionX[Index];
+	const float StartY = PositionY[Index];
+
+	float ForwardY, ForwardX;
+	FMath::SinCos(&ForwardY, &ForwardX, FMath::DegreesToRadians(Yaw[Index]));
+
+	const float ToTargetX = TargetX[Index] - StartX;
+	const float ToTargetY = TargetY[Index] - StartY;
+
+	// Turn towards the side of the target, positive turns towards +Y
+	const float Cross = ForwardX * ToTargetY - ForwardY * ToTargetX;
+	const float Sign = Cross >= 0.f ? 1.f : -1.f;
+
+	// Tightest turn the angular velocity allows at the fastest speed the fish swims the arc at
+	const float AngularVelocity = FMath::DegreesToRadians(FMath::Max(MaxAngularVelocity[Index], 1.f));
+	float Radius = FMath::Max(FMath::Max(Speed[Index], MaxSpeed[Index]) / AngularVelocity, KINDA_SMALL_NUMBER);
+	float CenterX = StartX - ForwardY * Sign * Radius;
+	float CenterY = StartY + ForwardX * Sign * Radius;
+	float CenterToTargetSquared = FMath::Square(TargetX[Index] - CenterX) + FMath::Square(TargetY[Index] - CenterY);
+
+	// A target inside the turning circle cannot be reached by an arc and a line, a single tighter arc through it is used instead
+	if (CenterToTargetSquared < Radius * Radius)
+	{
+		Radius = (ToTargetX * ToTargetX + ToTargetY * ToTargetY) / (2.f * FMath::Max(FMath::Abs(Cross), KINDA_SMALL_NUMBER));
+		CenterX = StartX - ForwardY * Sign * Radius;
+		CenterY = StartY + ForwardX * Sign * Radius;
+		CenterToTargetSquared = Radius * Radius;
+	}
+
+	// The arc ends where its tangent points at the target
+	const float StartAngle = FMath::Atan2(StartY - CenterY, StartX - CenterX);
+	const float TargetAngle = FMath::Atan2(TargetY[Index] - CenterY, TargetX[Index] - CenterX);
+	const float TangentOffset = FMath::Acos(FMath::Clamp(Radius / FMath::Max(FMath::Sqrt(CenterToTargetSquared), Radius), -1.f, 1.f));
+	float Sweep = FMath::Fmod(Sign * (TargetAngle - Sign * TangentOffset - StartAngle), 2.f * PI);
+
+	if (Sweep < 0.f)
+		Sweep += 2.f * PI;
+
+	// A target straight ahead can come out as a full circle
+	if (Sweep > 2.f * PI - KINDA_SMALL_NUMBER)
+		Sweep = 0.f;
+
+	const float EndAngle = StartAngle + Sign * Sweep;
+
+	PathDistance[Index] = 0.f;
+	PathStartYaw[Index] = Yaw[Index];
+	ArcCenterX[Index] = CenterX;
+	ArcCenterY[Index] = CenterY;
+	ArcRadius[Index] = Radius;
+	ArcStartAngle[Index] = StartAngle;
+	ArcCurvature[Index] = Sign / Radius;
+	ArcLength[Index] = Sweep * Radius;
+
+	// The line continues the heading at the end of the arc, past the target when the fish keeps swimming
+	LineStartX[Index] = CenterX + FMath::Cos(EndAngle) * Radius;
+	LineStartY[Index] = CenterY + FMath::Sin(EndAngle) * Radius;
+	LineYaw[Index] = FRotator::NormalizeAxis(Yaw[Index] + FMath::RadiansToDegrees(Sign * Sweep));
+	FMath::SinCos(&LineDirectionY[Index], &LineDirectionX[Index], FMath::DegreesToRadians(LineYaw[Index]));
+
+	const float LineLength = (TargetX[Index] - LineStartX[Index]) * LineDirectionX[Index] + (TargetY[Index] - LineStartY[Index]) * LineDirectionY[Index];
+	PathLength[Index] = ArcLength[Index] + FMath::Max(LineLength, 0.f);
+}
+
+void FFishSwarm::EvaluatePath(const int32 Index, const float Distance, float& OutX, float& OutY, float& OutYaw) const
+{
+	if (Distance >= ArcLength[Index])
+	{
+		const float Along = Distance - ArcLength[Index];
+		OutX = LineStartX[Index] + LineDirectionX[Index] * Along;
+		OutY = LineStartY[Index] + LineDirectionY[Index] * Along;
+		OutYaw = LineYaw[Index];
+		return;
+	}
+
+	// Still on the arc
+	const float Turned = ArcCurvature[Index] * Distance;
+	float Sin, Cos;
+	FMath::SinCos(&Sin, &Cos, ArcStartAngle[Index] + Turned);
+
+	OutX = ArcCenterX[Index] + Cos * ArcRadius[Index];
+	OutY = ArcCenterY[Index] + Sin * ArcRadius[Index];
+	OutYaw = FRotator::NormalizeAxis(PathStartYaw[Index] + FMath::RadiansToDegrees(Turned));
+}
+
+void FFishSwarm::MoveTowardsInterest(const int32 Index, const float DeltaTime)
+{
+	const float Distance = PathDistance[Index] + Speed[Index] * DeltaTime;
+	PathDistance[Index] = Distance;
+
+	if (State[Index] == EFishState::Swimming)
+		Speed[Index] = FMath::Min(FMath::Max(PathLength[Index] - Distance, 0.f), MaxSpeed[Index]);
+
+	EvaluatePath(Index, Distance, PositionX[Index], PositionY[Index], Yaw[Index]);
+
+	if (Distance >= ArcLength[Index])
+		return;
+
+	// Wiggle animation, only while turning and worth seeing
+	if (Significance[Index] == EFishSignificance::Low)
+	{
+		WiggleYaw[Index] = 0.f;
+		return;
+	}
+
+	WiggleSineInput[Index] += DeltaTime * WiggleSpeedFactor[Index];
+	WiggleYaw[Index] = FMath::Sin(WiggleSineInput[Index]) * MaxWiggleAngle[Index];
+}
+
+void FFishSwarm::MoveTowardsInterestBatch(const int32 FirstIndex)
+{
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float Delta = VectorLoad(&StepTime[FirstIndex]);
+	const VectorRegister4Float IsDue = VectorCompareGT(Delta, Zero);
+
+	// None of the four fish takes a step this update
+	if (VectorMaskBits(IsDue) == 0)
+		return;
+
+	const VectorRegister4Float RadToDeg = VectorSetFloat1(180.f / PI);
+	const VectorRegister4Float HalfTurn = VectorSetFloat1(180.f);
+	const VectorRegister4Float FullTurn = VectorSetFloat1(360.f);
+
+	// Advance along the path, the fish that are not due have no step time and stay in place
+	const VectorRegister4Float Distance = VectorMultiplyAdd(VectorLoad(&Speed[FirstIndex]), Delta, VectorLoad(&PathDistance[FirstIndex]));
+	VectorStore(Distance, &PathDistance[FirstIndex]);
+
+	const VectorRegister4Float IsSwimming = VectorCompareEQ(
+		MakeVectorRegisterFloat(
+			static_cast<float>(State[FirstIndex]),
+			static_cast<float>(State[FirstIndex + 1]),
+			static_cast<float>(State[FirstIndex + 2]),
+			static_cast<float>(State[FirstIndex + 3])),
+		VectorSetFloat1(static_cast<float>(EFishState::Swimming)));
+
+	// Swimming fish slow down towards the end of the path
+	const VectorRegister4Float Remaining = VectorMax(VectorSubtract(VectorLoad(&PathLength[FirstIndex]), Distance), Zero);
+	VectorStore(
+		VectorSelect(IsSwimming, VectorMin(Remaining, VectorLoad(&MaxSpeed[FirstIndex])), VectorLoad(&Speed[FirstIndex])),
+		&Speed[FirstIndex]);
+
+	// Point on the arc
+	const VectorRegister4Float ArcDistance = VectorLoad(&ArcLength[FirstIndex]);
+	const VectorRegister4Float Turned = VectorMultiply(VectorLoad(&ArcCurvature[FirstIndex]), Distance);
+	const VectorRegister4Float Angle = VectorAdd(VectorLoad(&ArcStartAngle[FirstIndex]), Turned);
+	const VectorRegister4Float Radius = VectorLoad(&ArcRadius[FirstIndex]);
+	VectorRegister4Float Sin, Cos;
+	VectorSinCos(&Sin, &Cos, &Angle);
+
+	const VectorRegister4Float ArcX = VectorMultiplyAdd(Cos, Radius, VectorLoad(&ArcCenterX[FirstIndex]));
+	const VectorRegister4Float ArcY = VectorMultiplyAdd(Sin, Radius, VectorLoad(&ArcCenterY[FirstIndex]));
+	VectorRegister4Float ArcYaw = VectorMultiplyAdd(Turned, RadToDeg, VectorLoad(&PathStartYaw[FirstIndex]));
+	ArcYaw = VectorSubtract(ArcYaw, VectorSelect(VectorCompareGT(ArcYaw, HalfTurn), FullTurn, Zero));
+	ArcYaw = VectorAdd(ArcYaw, VectorSelect(VectorCompareLE(ArcYaw, VectorNegate(HalfTurn)), FullTurn, Zero));
+
+	// Point on the line
+	const VectorRegister4Float Along = VectorMax(VectorSubtract(Distance, ArcDistance), Zero);
+	const VectorRegister4Float LineX = VectorMultiplyAdd(VectorLoad(&LineDirectionX[FirstIndex]), Along, VectorLoad(&LineStartX[FirstIndex]));
+	const VectorRegister4Float LineY = VectorMultiplyAdd(VectorLoad(&LineDirectionY[FirstIndex]), Along, VectorLoad(&LineStartY[FirstIndex]));
+
+	const VectorRegister4Float IsTurning = VectorCompareLT(Distance, ArcDistance);
+	VectorStore(VectorSelect(IsTurning, ArcX, LineX), &PositionX[FirstIndex]);
+	VectorStore(VectorSelect(IsTurning, ArcY, LineY), &PositionY[FirstIndex]);
+	VectorStore(VectorSelect(IsTurning, ArcYaw, VectorLoad(&LineYaw[FirstIndex])), &Yaw[FirstIndex]);
+
+	// Wiggle animation, only while turning and worth seeing, low significance fish swim straight
+	const VectorRegister4Float IsHighSignificance = VectorCompareEQ(
+		MakeVectorRegisterFloat(
+			static_cast<float>(Significance[FirstIndex]),
+			static_cast<float>(Significance[FirstIndex + 1]),
+			static_cast<float>(Significance[FirstIndex + 2]),
+			static_cast<float>(Significance[FirstIndex + 3])),
+		VectorSetFloat1(static_cast<float>(EFishSignificance::High)));
+	const VectorRegister4Float IsWiggling = VectorBitwiseAnd(IsTurning, IsHighSignificance);
+
+	const VectorRegister4Float SineInput = VectorAdd(
+		VectorLoad(&WiggleSineInput[FirstIndex]),
+		VectorSelect(IsWiggling, VectorMultiply(Delta, VectorLoad(&WiggleSpeedFactor[FirstIndex])), Zero));
+	VectorStore(SineInput, &WiggleSineInput[FirstIndex]);
+	VectorStore(
+		VectorSelect(
+			IsWiggling,
+			VectorMultiply(VectorSin(SineInput), VectorLoad(&MaxWiggleAngle[FirstIndex])),
+			VectorSelect(IsHighSignificance, VectorLoad(&WiggleYaw[FirstIndex]), Zero)),
+		&WiggleYaw[FirstIndex]);
+}
+
+void FFishSwarm::ConsiderChangingTarget(const int32 Index, const float DeltaTime, const FVector* LureRelativeLocation)
+{
+	TargetChangeTimer[Index] += DeltaTime;
+
+	const float RemainingPath = PathLength[Index] - PathDistance[Index];
+
+	if (TargetChangeTimer[Index] <= GetParams(Index).TargetChangeTime && RemainingPath >= 1.f)
+		return;
+
+	// Runs on the workers, the random values come from the fish own generator
+	const int32 RandomValue = 1 + static_cast<int32>(NextRandom(RandomState[Index]) * 100.f);
+	Iterations[Index]++;
+	TargetChangeTimer[Index] = 0;
+
+	if (LureRelativeLocation
+		&& FVector::Dist(FVector(PositionX[Index], PositionY[Index], PositionZ[Index]), *LureRelativeLocation) < GetParams(Index).LureDetectionRadius
+		&& RandomValue <= GetParams(Index).ChoosingLureProbability)
+	{
+		TargetX[Index] = LureRelativeLocation->X;
+		TargetY[Index] = LureRelativeLocation->Y;
+	}
+	else
+	{
+		TargetX[Index] = FMath::RoundToFloat(NextRandom(RandomState[Index]) * 200.f) - 100.f;
+		TargetY[Index] = FMath::RoundToFloat(NextRandom(RandomState[Index]) * 200.f) - 100.f;
+	}
+
+	PlanPath(Index);
+}
+
+bool FFishSwarm::FadeIn(const int32 Index, const float DeltaTime)
+{
+	// Same as the actor version, the opacity caps at 0.9 so entering fish keep their spawn speed
+	if (Opacity[Index] < 1.f)
+	{
+		Opacity[Index] = FMath::Min(Opacity[Index] + DeltaTime * GetParams(Index).FadeInOutSpeed, 0.9f);
+		return false;
+	}
+
+	return true;
+}
+
+bool FFishSwarm::FadeOut(const int32 Index, const float DeltaTime)
+{
+	if (Opacity[Index] > 0.f)
+	{
+		Opacity[Index] = FMath::Max(Opacity[Index] - DeltaTime * GetParams(Index).FadeInOutSpeed * 2, 0.f);
+		return false;
+	}
+
+	return true;
+}
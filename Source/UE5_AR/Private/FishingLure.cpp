@@ -2,8 +2,10 @@
 
 #include "FishingLure.h"
 
+#include "ARPin.h"
 #include "CustomARPawn.h"
-#include "GameplayPlane.h"
+#include "FishingPond.h"
+#include "SfxSubsystem.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Camera/CameraComponent.h"
 #include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
@@ -15,8 +17,11 @@ AFishingLure::AFishingLure()
 	RealLureMeshComponent->SetupAttachment(RootComponent);
 	RealLureMeshComponent->SetVisibility(false);
 	RealLureMeshComponent->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
+	RealLureMeshComponent->SetGenerateOverlapEvents(false);
 
+	// The fish around the lure are found by the pond, no overlap events needed
 	StaticMeshComponent->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
+	StaticMeshComponent->SetGenerateOverlapEvents(false);
 }
 
 void AFishingLure::Tick(float DeltaTime)
@@ -26,33 +31,95 @@ void AFishingLure::Tick(float DeltaTime)
 	// Reset catching for the frame
 	bIsCatchingAFish = false;
 
+	// The aiming is done in the late aim tick
 	switch(State)
 	{
-		case Visualisation:
-			VisualisationUpdate();
+		case Casting:
+			SimulationUpdate(DeltaTime);
 			break;
 
-		case Casting:
-			if (MockCoro_FallingAnimation(DeltaTime))
-				State = Floating;
+		case Floating:
+			MockCoro_FloatingAnimation(DeltaTime);
+			SimulationUpdate(DeltaTime);
+			break;
 
+		default:
+			break;
+	}
+}
+
+void AFishingLure::RegisterActorTickFunctions(bool bRegister)
+{
+	Super::RegisterActorTickFunctions(bRegister);
+
+	if (!bRegister)
+	{
+		LateAimTick.Unregister();
+		return;
+	}
+
+	LateAimTick.Register(this, [this](float) { LateAimUpdate(); });
+
+	// The camera pose the frame is rendered with is tracked by the player
+	if (auto* Player = Cast<ACustomARPawn>(UGameplayStatics::GetPlayerPawn(this, 0)))
+		LateAimTick.AddPrerequisite(Player, Player->GetLateUpdateTick());
+}
+
+void AFishingLure::LateAimUpdate()
+{
+	// The aimed point only changes with the camera, it is found again after a move or a state change
+	const auto* Player = Cast<ACustomARPawn>(UGameplayStatics::GetPlayerPawn(this, 0));
+
+	if (!IsValid(Player))
+		return;
+
+	// The predicted pose keeps moving until the filter settles, the aim follows it instead of the tracked one
+	AimPose.Update(Player->GetPredictedCameraPose());
+
+	if (State != AimedState || AimPose.HasMoved())
+		bIsAimUpToDate = false;
+
+	AimedState = State;
+
+	switch(State)
+	{
+		case Visualisation:
+			VisualisationUpdate();
 			break;
 
 		case Floating:
-			MockCoro_FloatingAnimation(DeltaTime);
-			FloatingUpdate(DeltaTime);
+			FloatingUpdate();
+			break;
+
+		default:
 			break;
 	}
 }
 
-void AFishingLure::OnSuddenPlayerMove(const FVector& MovementDelta)
+void AFishingLure::OnSuddenPlayerMove(const FVector& MovementVelocity)
 {
 	ReelIn();
 }
 
+void AFishingLure::OnReleasedToPool()
+{
+	Super::OnReleasedToPool();
+
+	State = Visualisation;
+	bIsCatchingAFish = false;
+	bIsCastable = false;
+	bIsAimUpToDate = false;
+	MockCoro_FallingAnimation_Speed = 150;
+	MockCoro_FallingAnimation_AnimationStep = 0;
+	MockCoro_FloatingAnimation_SineInput = 0.f;
+	RealLureMeshComponent->SetVisibility(false);
+	RealLureMeshComponent->SetRelativeLocation(FVector::ZeroVector);
+}
+
 void AFishingLure::StartFalling()
 {
 	State = Casting;
+	ResetSimulation();
 }
 
 void AFishingLure::ReelIn()
@@ -64,7 +131,9 @@ void AFishingLure::ReelIn()
 		UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, SplashSystem, GetActorLocation());
 
 	if (IsValid(SplashSfx))
-		UGameplayStatics::PlaySoundAtLocation(this, SplashSfx, GetActorLocation());
+		USfxSubsystem::PlaySoundAtLocation(this, SplashSfx, GetActorLocation());
+
+	DisturbPondSurface(0.7f);
 
 	RealLureMeshComponent->SetVisibility(false);
 	StaticMeshComponent->SetVisibility(true);
@@ -80,6 +149,7 @@ void AFishingLure::CastLure()
 	StaticMeshComponent->SetVisibility(false);
 	RealLureMeshComponent->SetVisibility(true);
 	State = Casting;
+	ResetSimulation();
 }
 
 bool AFishingLure::MockCoro_FallingAnimation(const float DeltaTime)
@@ -103,7 +173,9 @@ bool AFishingLure::MockCoro_FallingAnimation(const float DeltaTime)
 					UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, SplashSystem, GetActorLocation());
 
 				if (IsValid(SplashSfx))
-					UGameplayStatics::PlaySoundAtLocation(this, SplashSfx, GetActorLocation());
+					USfxSubsystem::PlaySoundAtLocation(this, SplashSfx, GetActorLocation());
+
+				DisturbPondSurface(1.f);
 
 				MockCoro_FallingAnimation_AnimationStep++;
 			}
@@ -139,82 +211,145 @@ void AFishingLure::MockCoro_FloatingAnimation(const float DeltaTime)
 
 void AFishingLure::VisualisationUpdate()
 {
-	TArray<FHitResult> TraceResultObj;
-	auto Player = Cast<ACustomARPawn>(UGameplayStatics::GetPlayerPawn(this, 0));
-
-	if (!IsValid(Player))
+	if (bIsAimUpToDate)
 		return;
 
-	const auto StartTracePosition = Player->CameraComponent->GetComponentLocation();
-	const auto EndTracePosition = StartTracePosition + Player->CameraComponent->GetForwardVector() * 1000;
-	GWorld->LineTraceMultiByChannel(
-		TraceResultObj,
-		StartTracePosition,
-		EndTracePosition,
-		ECollisionChannel::ECC_Pawn
-		);
-
-	AGameplayPlane* FoundPlane = nullptr;
+	bIsAimUpToDate = true;
 	FVector HitPosition;
 
-	for(auto It : TraceResultObj)
-	{
-		if(auto PotentialPlane = Cast<AGameplayPlane>(It.GetActor()))
-		{
-			FoundPlane = PotentialPlane;
-			HitPosition = It.ImpactPoint;
-			FloatTowardsPoint = It.ImpactPoint;
-			break;
-		}
-	}
-
-	if (!IsValid(FoundPlane))
+	if (!FindAimedPlanePoint(HitPosition))
 	{
 		bIsCastable = false;
 		StaticMeshComponent->SetVisibility(false);
 		return;
 	}
 
+	FloatTowardsPoint = HitPosition;
 	StaticMeshComponent->SetVisibility(true);
 	bIsCastable = true;
 	SetARPosition(HitPosition);
 	auto RelativeLocation = RelativeTransform.GetLocation();
 	RelativeLocation.Z -= 8;
 	RelativeTransform.SetLocation(RelativeLocation);
+
+	// Placed right away, the pin transform of the regular tick would show it a frame late
+	if (IsValid(PinComponent))
+		SetActorTransform(RelativeTransform * PinComponent->GetLocalToWorldTransform());
 }
 
-void AFishingLure::FloatingUpdate(const float DeltaTime)
+void AFishingLure::FloatingUpdate()
 {
-	TArray<FHitResult> TraceResultObj;
-	auto Player = Cast<ACustomARPawn>(UGameplayStatics::GetPlayerPawn(this, 0));
+	if (bIsAimUpToDate)
+		return;
+
+	bIsAimUpToDate = true;
+	FVector HitPosition;
+
+	if (FindAimedPlanePoint(HitPosition))
+		FloatTowardsPoint = HitPosition;
+}
+
+void AFishingLure::DisturbPondSurface(const float Strength) const
+{
+	const auto* GM = Cast<ACustomGameMode>(UGameplayStatics::GetGameMode(this));
+	auto* Pond = IsValid(GM) ? Cast<AFishingPond>(GM->GetGameplayPlane()) : nullptr;
+
+	if (IsValid(Pond))
+		Pond->DisturbSurface(RelativeTransform.GetLocation(), Strength);
+}
+
+bool AFishingLure::FindAimedPlanePoint(FVector& OutHitPosition) const
+{
+	const auto* Player = Cast<ACustomARPawn>(UGameplayStatics::GetPlayerPawn(this, 0));
 
 	if (!IsValid(Player))
-		return;
+		return false;
+
+	// Aimed with the camera pose predicted for display, the lure keeps up with the hand at low frame rates
+	constexpr float AimDistance = 1000.f;
+	const auto StartTracePosition = AimPose.GetPose().GetLocation();
+	const auto TraceDirection = AimPose.GetPose().GetRotation().GetForwardVector();
+
+	const auto* GM = Cast<ACustomGameMode>(UGameplayStatics::GetGameMode(this));
+	const auto* Plane = IsValid(GM) ? GM->GetGameplayPlane() : nullptr;
 
-	const auto StartTracePosition = Player->CameraComponent->GetComponentLocation();
-	const auto EndTracePosition = StartTracePosition + Player->CameraComponent->GetForwardVector() * 1000;
+	if (IsValid(Plane) && Plane->CanIntersectRay())
+		return Plane->IntersectRay(StartTracePosition, TraceDirection, AimDistance, OutHitPosition);
+
+	TArray<FHitResult> TraceResultObj;
 	GWorld->LineTraceMultiByChannel(
 		TraceResultObj,
 		StartTracePosition,
-		EndTracePosition,
+		StartTracePosition + TraceDirection * AimDistance,
 		ECollisionChannel::ECC_Pawn
 	);
 
-	AGameplayPlane* FoundPlane = nullptr;
+	for (const auto& It : TraceResultObj)
+	{
+		if (Cast<AGameplayPlane>(It.GetActor()))
+		{
+			OutHitPosition = It.ImpactPoint;
+			return true;
+		}
+	}
+
+	return false;
+}
 
-	for (auto It : TraceResultObj)
+void AFishingLure::SimulationUpdate(const float DeltaTime)
+{
+	// The rendered position is interpolated, the simulation continues from the last simulated one
+	RelativeTransform.SetLocation(SimulatedLocation);
+
+	const int32 Steps = SimulationClock.Advance(DeltaTime);
+
+	for (int32 Step = 0; Step < Steps; Step++)
 	{
-		if (auto PotentialPlane = Cast<AGameplayPlane>(It.GetActor()))
+		PreviousSimulatedLocation = RelativeTransform.GetLocation();
+
+		if (State == Casting)
 		{
-			FoundPlane = PotentialPlane;
-			FloatTowardsPoint = It.ImpactPoint;
-			break;
+			const bool bIsLifting = MockCoro_FallingAnimation_AnimationStep == 0;
+
+			if (MockCoro_FallingAnimation(SimulationClock.GetStepTime()))
+				State = Floating;
+
+			// The lift to the casting height is a teleport, not interpolated
+			if (bIsLifting)
+				PreviousSimulatedLocation = RelativeTransform.GetLocation();
+		}
+		else if (State == Floating)
+		{
+			FloatTowardsTarget(SimulationClock.GetStepTime());
 		}
 	}
 
-	auto FloatDirection = FloatTowardsPoint - GetActorLocation();
+	SimulatedLocation = RelativeTransform.GetLocation();
+	RelativeTransform.SetLocation(FMath::Lerp(PreviousSimulatedLocation, SimulatedLocation, SimulationClock.GetAlpha()));
+
+	// Without a pin the relative transform is not applied by the placeable actor
+	if (!IsValid(PinComponent))
+		SetActorLocation(RelativeTransform.GetLocation());
+}
+
+void AFishingLure::FloatTowardsTarget(const float StepTime)
+{
+	const auto TargetLocation = IsValid(PinComponent) ?
+		PinComponent->GetLocalToWorldTransform().InverseTransformPosition(FloatTowardsPoint) :
+		FloatTowardsPoint;
+
+	auto RelativeLocation = RelativeTransform.GetLocation();
+	auto FloatDirection = TargetLocation - RelativeLocation;
 	float Distance = FloatDirection.Length();
 	FloatDirection.Normalize();
-	Distance = FMath::Min(Distance, FloatMovingSpeed) * DeltaTime;
-	SetARPosition(GetActorLocation() + FloatDirection * Distance);
+	Distance = FMath::Min(Distance, FloatMovingSpeed) * StepTime;
+	RelativeLocation += FloatDirection * Distance;
+	RelativeTransform.SetLocation(RelativeLocation);
+}
+
+void AFishingLure::ResetSimulation()
+{
+	SimulationClock.SetRate(SimulationRate, MaxSimulationStepsPerFrame);
+	SimulatedLocation = IsValid(PinComponent) ? RelativeTransform.GetLocation() : GetActorLocation();
+	PreviousSimulatedLocation = SimulatedLocation;
 }
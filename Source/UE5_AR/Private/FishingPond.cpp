@@ -2,9 +2,24 @@
 
 #include "FishingPond.h"
 
+#include "ARPin.h"
 #include "CustomARPawn.h"
+#include "FishSpeciesData.h"
+#include "HapticsSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Scalability.h"
+#include "Net/UnrealNetwork.h"
 #include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
 
+AFishingPond::AFishingPond()
+{
+	// Players sharing the pond see the fish simulated by the server
+	bReplicates = true;
+	bAlwaysRelevant = true;
+}
+
 AFishingPond::~AFishingPond()
 {
 	// Disable Player motion sensing
@@ -27,6 +42,89 @@ void AFishingPond::BeginPlay()
 
 	if (IsValid(Player))
 		Player->bIsProcessingMotion = true;
+
+	// Ponds set up before the species data still list the fish classes, their values are taken from the class defaults
+	if (FishSpecies.IsEmpty())
+	{
+		for (const auto& It : FishClasses)
+		{
+			if (auto* Species = UFishSpeciesData::CreateFromFishClass(this, It))
+				FishSpecies.Add(Species);
+		}
+	}
+
+	// Fish come and go all the time, spawning them upfront avoids the hitches
+	// The clients only draw the silhouettes, they have no fish actors
+	auto* Pool = HasAuthority() ? GetWorld()->GetSubsystem<UActorPoolSubsystem>() : nullptr;
+
+	if (Pool)
+	{
+		for (const auto* It : FishSpecies)
+		{
+			if (IsValid(It))
+				Pool->Prewarm(It->FishClass, FMath::Min(MaxFish, PrewarmedFishPerClass));
+		}
+	}
+
+	// The simulation reads the tuning values per species, indices match the species array
+	TArray<FFishSwarmParams> SpeciesParams;
+
+	for (const auto* It : FishSpecies)
+		SpeciesParams.Add(IsValid(It) ? It->MakeSwarmParams() : FFishSwarmParams());
+
+	Swarm.SetSpeciesParams(SpeciesParams);
+
+	TArray<float> SpawnWeights;
+
+	for (const auto* It : FishSpecies)
+		SpawnWeights.Add(IsValid(It) ? It->SpawnWeight : 0.f);
+
+	SpeciesTable.Build(SpawnWeights);
+	SpawnDirector.Reset(MinFish, MaxFish, FishSpawnTime, FrameTimeBudget);
+
+	SimulationClock.SetRate(SimulationRate, MaxSimulationStepsPerFrame);
+	Swarm.LowSignificanceInterval = LowSignificanceInterval;
+	CreateSilhouetteComponents();
+	CreateRipples();
+
+	// The server sends the fish states at a low rate, the clients follow the paths in between
+	ReplicatedFish.Pond = this;
+	Swarm.bIsReplica = !HasAuthority();
+
+	if (HasAuthority())
+		NetUpdateFrequency = ReplicationRate;
+
+	// The fish received before the species were known
+	if (Swarm.bIsReplica)
+	{
+		for (const auto& It : ReplicatedFish.Items)
+			OnReplicatedFishChanged(It);
+	}
+}
+
+void AFishingPond::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Swimming fish do not outlive the pond, the reeled in ones are handled on their own
+	for (auto* It : SwarmFish)
+	{
+		if (!IsValid(It))
+			continue;
+
+		It->SwarmIndex = INDEX_NONE;
+		UActorPoolSubsystem::ReleaseActor(It);
+	}
+
+	SwarmFish.Empty();
+	Swarm.Empty();
+	RippleSimulation.Wait();
+
+	if (HasAuthority())
+	{
+		ReplicatedFish.Items.Empty();
+		ReplicatedFish.MarkArrayDirty();
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AFishingPond::Tick(float DeltaTime)
@@ -36,24 +134,142 @@ void AFishingPond::Tick(float DeltaTime)
 	// Has to be done here as the PinComponent is assigned after BeginPlay()
 	if (!IsValid(PlayerLure) && IsValid(LureClass) && !bIsClosing)
 	{
-		PlayerLure = Cast<AFishingLure>(GWorld->SpawnActor(LureClass));
+		PlayerLure = UActorPoolSubsystem::AcquireActor<AFishingLure>(this, LureClass);
 		if (IsValid(PlayerLure))
 			PlayerLure->PinComponent = PinComponent;
 	}
 
-	if (!bIsClosing)
-		MockCoro_FishSpawner(DeltaTime);
+	// The clients only follow the fish of the server
+	if (!bIsClosing && HasAuthority())
+		UpdatePopulation(DeltaTime);
+
+	UpdateSwarm(DeltaTime);
+
+	if (HasAuthority())
+		UpdateReplication(DeltaTime);
+
+	UpdateRipples(DeltaTime);
+}
+
+void AFishingPond::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AFishingPond, ReplicatedFish);
+}
+
+void AFishingPond::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// The fish are not owned by the pond, yet they stay and go with it
+	for (auto* It : SwarmFish)
+	{
+		if (!IsValid(It))
+			continue;
+
+		It->GetResourceSizeEx(CumulativeResourceSize);
+
+		for (auto* Component : TInlineComponentArray<UActorComponent*>(It))
+			Component->GetResourceSizeEx(CumulativeResourceSize);
+	}
+}
+
+void AFishingPond::OnReplicatedFishChanged(const FReplicatedFish& Fish)
+{
+	// Items arriving before BeginPlay are applied from there, once the species are known
+	if (HasAuthority() || !(HasActorBegunPlay() || IsActorBeginningPlay()))
+		return;
+
+	int32 Index = Swarm.NetId.Find(Fish.Id);
+
+	if (Index == INDEX_NONE)
+	{
+		if (!FishSpecies.IsValidIndex(Fish.Species))
+			return;
+
+		const auto Position = FVector(FReplicatedFish::DequantizePosition(Fish.X), FReplicatedFish::DequantizePosition(Fish.Y), -1);
+		Index = Swarm.Add(Position, Position, Fish.Species);
+		Swarm.NetId[Index] = Fish.Id;
+		SwarmFish.Add(nullptr);
+		MaxLureDetectionRadius = FMath::Max(MaxLureDetectionRadius, Swarm.GetParams(Index).LureDetectionRadius);
+		CurrentFishCount++;
+	}
+
+	Fish.Read(Swarm, Index);
+	bIsFishGridDirty = true;
 }
 
-AFish* AFishingPond::AddFish(const int ClassIndex, const FVector &RelativePosition, const FVector& PointOfInterest)
+void AFishingPond::OnReplicatedFishRemoved(const FReplicatedFish& Fish)
 {
-	if (CurrentFishCount >= MaxFish || ClassIndex < 0 || ClassIndex >= FishClasses.Num())
+	if (HasAuthority())
+		return;
+
+	const int32 Index = Swarm.NetId.Find(Fish.Id);
+
+	if (Index != INDEX_NONE)
+		RemoveSwarmFishAt(Index, false);
+}
+
+void AFishingPond::Suspend()
+{
+	Super::Suspend();
+
+	auto* Player = Cast<ACustomARPawn>(UGameplayStatics::GetPlayerPawn(this, 0));
+
+	if (IsValid(Player))
+		Player->bIsProcessingMotion = false;
+}
+
+void AFishingPond::Resume()
+{
+	Super::Resume();
+
+	auto* Player = Cast<ACustomARPawn>(UGameplayStatics::GetPlayerPawn(this, 0));
+
+	if (IsValid(Player))
+		Player->bIsProcessingMotion = true;
+
+	// The time spent suspended is not simulated, the fish continue from where they were
+	SimulationClock.Reset();
+}
+
+AFish* AFishingPond::AddFish(const int SpeciesIndex, const FVector &RelativePosition, const FVector& PointOfInterest)
+{
+	if (!HasAuthority() || CurrentFishCount >= MaxFish || !FishSpecies.IsValidIndex(SpeciesIndex) || !IsValid(FishSpecies[SpeciesIndex]))
+		return nullptr;
+
+	auto* SpeciesData = FishSpecies[SpeciesIndex];
+	auto* NewActor = UActorPoolSubsystem::AcquireActor<AFish>(this, SpeciesData->FishClass);
+
+	if (!IsValid(NewActor))
 		return nullptr;
 
-	auto* NewActor = Cast<AFish>(GWorld->SpawnActor(FishClasses[ClassIndex]));
+	NewActor->SetSpecies(SpeciesData);
+
+	// The pond moves, draws and detects the fish, the actor is dormant until it is reeled in
+	NewActor->SetActorTickEnabled(false);
+	NewActor->SetActorEnableCollision(false);
+	NewActor->StaticMeshComponent->SetVisibility(false);
 	NewActor->PinComponent = PinComponent;
 	NewActor->RelativeTransform.SetLocation(RelativePosition);
-	NewActor->RelativePointOfInterest = PointOfInterest;
+	NewActor->OwningPond = this;
+	NewActor->SwarmIndex = Swarm.Add(RelativePosition, PointOfInterest, static_cast<uint8>(SpeciesIndex));
+	SwarmFish.Add(NewActor);
+
+	// Sent with the next replication of the pond
+	Swarm.NetId[NewActor->SwarmIndex] = NextFishNetId++;
+
+	// 0 is the unset id
+	if (NextFishNetId == 0)
+		NextFishNetId = 1;
+
+	auto& Replicated = ReplicatedFish.Items.AddDefaulted_GetRef();
+	Replicated.Write(Swarm, NewActor->SwarmIndex);
+	ReplicatedFish.MarkItemDirty(Replicated);
+
+	MaxLureDetectionRadius = FMath::Max(MaxLureDetectionRadius, SpeciesData->LureDetectionRadius);
+	bIsFishGridDirty = true;
 	CurrentFishCount++;
 	return NewActor;
 }
@@ -63,33 +279,535 @@ void AFishingPond::RemoveFish(AFish* FishToRemove)
 	if (CurrentFishCount <= 0 || !IsValid(FishToRemove))
 		return;
 
+	if (FishToRemove->IsInSwarm() && FishToRemove->OwningPond == this)
+	{
+		RemoveSwarmFishAt(FishToRemove->SwarmIndex, true);
+		return;
+	}
+
 	//For removing fish that did not call this as a result of leaving the pond
 	if (!FishToRemove->ShouldNotRemoveFromWorld())
-		GWorld->DestroyActor(FishToRemove);
+		UActorPoolSubsystem::ReleaseActor(FishToRemove);
 
 	CurrentFishCount--;
 }
 
+void AFishingPond::DetachFish(AFish* FishToDetach)
+{
+	if (!IsValid(FishToDetach) || !FishToDetach->IsInSwarm() || FishToDetach->OwningPond != this)
+		return;
+
+	const int32 Index = FishToDetach->SwarmIndex;
+	FishToDetach->RelativeTransform.SetLocation(FVector(Swarm.PositionX[Index], Swarm.PositionY[Index], Swarm.PositionZ[Index]));
+	FishToDetach->RelativeTransform.SetRotation(FRotator(0, Swarm.Yaw[Index], 0).Quaternion());
+
+	// The actor draws itself from now on, until the reel in switches to the real mesh
+	FishToDetach->ShowOwnSilhouette(Swarm.Opacity[Index]);
+
+	// Still present in the pond until caught or escaped
+	RemoveSwarmFishAt(Index, false);
+	CurrentFishCount++;
+
+	FishToDetach->SetActorEnableCollision(true);
+	FishToDetach->SetActorTickEnabled(true);
+}
+
+FTransform AFishingPond::GetPondTransform() const
+{
+	if (IsValid(PinComponent))
+		return PinComponent->GetLocalToWorldTransform();
+
+	return GetActorTransform();
+}
+
+const FFishGrid& AFishingPond::GetFishGrid()
+{
+	if (bIsFishGridDirty)
+	{
+		FishGrid.Build(Swarm.PositionX, Swarm.PositionY, FishGridCellSize);
+		bIsFishGridDirty = false;
+	}
+
+	return FishGrid;
+}
+
+bool AFishingPond::SpookSwarmFish(const int32 Index, const FVector& RelativeSpookSource)
+{
+	if (!Swarm.Spook(Index, RelativeSpookSource))
+		return false;
+
+	DisturbSurface(FVector(Swarm.PositionX[Index], Swarm.PositionY[Index], 0.f), 0.5f, 4.f);
+
+	// The panic spreads to the fish around, but not any further
+	GetFishGrid().ForEachInRadius(
+		Swarm.PositionX[Index],
+		Swarm.PositionY[Index],
+		SpookPropagationRadius,
+		[this, &RelativeSpookSource](const int32 Neighbour, const float)
+		{
+			Swarm.Spook(Neighbour, RelativeSpookSource);
+		}
+	);
+
+	return true;
+}
+
+void AFishingPond::DisturbSurface(const FVector& RelativePosition, const float Strength, const float Radius)
+{
+	const float Size = 2.f * RippleExtent;
+
+	RippleSimulation.AddImpulse(
+		(RelativePosition.X + RippleExtent) / Size,
+		(RelativePosition.Y + RippleExtent) / Size,
+		Strength,
+		Radius / Size
+	);
+}
+
 bool AFishingPond::GetValidLureRelativeLocation(FVector& LureRelativeLocation)
 {
-	if (!PlayerLure->IsDesirable())
+	if (!IsValid(PlayerLure) || !PlayerLure->IsDesirable())
 		return false;
 
 	LureRelativeLocation = PlayerLure->RelativeTransform.GetLocation();
 	return true;
 }
 
-void AFishingPond::MockCoro_FishSpawner(const float DeltaTime)
+void AFishingPond::UpdatePopulation(const float DeltaTime)
+{
+	// The fish on their way out no longer count, otherwise one slow leaver would block the spawning
+	int32 Population = CurrentFishCount;
+	int32 LeaveCandidate = INDEX_NONE;
+
+	for (int32 Index = 0; Index < Swarm.Num(); Index++)
+	{
+		if (Swarm.State[Index] == EFishState::Leaving)
+		{
+			Population--;
+			continue;
+		}
+
+		// Prefer sending away the fish the player is not looking at
+		if (LeaveCandidate == INDEX_NONE || Swarm.Significance[Index] == EFishSignificance::Low)
+			LeaveCandidate = Index;
+	}
+
+	const int32 Change = SpawnDirector.Update(DeltaTime, FSpawnDirector::MeasureFrameTime(), Population);
+
+	if (Change > 0)
+	{
+		AddFish(
+			SpeciesTable.Sample(FMath::FRand()),
+			FVector(FMath::RandRange(-100, 100), FMath::RandRange(-100, 100), -1),
+			FVector(FMath::RandRange(-100, 100), FMath::RandRange(-100, 100), 0)
+		);
+	}
+	else if (Change < 0 && LeaveCandidate != INDEX_NONE)
+	{
+		Swarm.LeavePond(LeaveCandidate);
+	}
+}
+
+void AFishingPond::UpdateSwarm(const float DeltaTime)
 {
-	MockCoro_FishSpawner_Timer += DeltaTime;
-	if (MockCoro_FishSpawner_Timer < FishSpawnTime)
+	const auto PondTransform = GetPondTransform();
+	UpdateSignificance(PondTransform);
+
+	// The simulation runs at a fixed rate, the rendered fish are interpolated between the last two steps
+	const int32 Steps = SimulationClock.Advance(DeltaTime);
+
+	for (int32 Step = 0; Step < Steps; Step++)
+		SimulateSwarm(SimulationClock.GetStepTime());
+
+	// Transforms of the frame, shared by the silhouettes and the fish actors
+	const float Alpha = SimulationClock.GetAlpha();
+	InterpolatedTransforms.Reset();
+
+	for (int32 Index = 0; Index < Swarm.Num(); Index++)
+		InterpolatedTransforms.Add(Swarm.GetInterpolatedRelativeTransform(Index, Alpha, SimulationClock.GetStepTime()));
+
+	UpdateSilhouettes(PondTransform);
+
+	if (IsValid(PinComponent) && PinComponent->GetTrackingState() != EARTrackingState::Tracking)
+		return;
+
+	// The hidden fish actors only matter close to the player, the low detail ones are synced once they become relevant
+	for (int32 Index = 0; Index < SwarmFish.Num(); Index++)
+	{
+		if (IsValid(SwarmFish[Index]) && Swarm.Significance[Index] == EFishSignificance::High)
+			SwarmFish[Index]->UpdateFromSwarm(InterpolatedTransforms[Index], PondTransform);
+	}
+
+	// One force feedback request for all the fish noticing the lure
+	if (FishNearLure.Num() > 0)
+		UHapticsSubsystem::RequestForceFeedback(this, 0.3f, EHapticPriority::Ambient);
+}
+
+void AFishingPond::UpdateReplication(const float DeltaTime)
+{
+	ReplicationTimer += DeltaTime;
+
+	if (ReplicationTimer < 1.f / FMath::Max(ReplicationRate, KINDA_SMALL_NUMBER))
 		return;
 
-	AddFish(
-		FMath::RandRange(0, FishClasses.Num() - 1),
-		FVector(FMath::RandRange(-100, 100), FMath::RandRange(-100, 100), -1),
-		FVector(FMath::RandRange(-100, 100), FMath::RandRange(-100, 100), 0)
+	const float Elapsed = ReplicationTimer;
+	ReplicationTimer = 0.f;
+
+	// Only the fish the clients would follow too loosely are written, the fast array sends just those
+	for (auto& It : ReplicatedFish.Items)
+	{
+		const int32 Index = Swarm.NetId.Find(It.Id);
+
+		if (Index == INDEX_NONE)
+			continue;
+
+		It.Age += Elapsed;
+
+		if (It.Age < ReplicationKeyframeTime && !It.HasDiverged(Swarm, Index, ReplicationTolerance))
+			continue;
+
+		It.Write(Swarm, Index);
+		ReplicatedFish.MarkItemDirty(It);
+	}
+}
+
+void AFishingPond::UpdateSignificance(const FTransform& PondTransform)
+{
+	auto* Player = Cast<ACustomARPawn>(UGameplayStatics::GetPlayerPawn(this, 0));
+
+	// Without a camera to rank by, everything stays in full detail
+	if (!IsValid(Player) || !IsValid(Player->CameraComponent))
+	{
+		for (auto& It : Swarm.Significance)
+			It = EFishSignificance::High;
+
+		return;
+	}
+
+	const auto CameraLocation = PondTransform.InverseTransformPosition(Player->CameraComponent->GetComponentLocation());
+	const auto CameraForward = PondTransform.InverseTransformVectorNoScale(Player->CameraComponent->GetForwardVector());
+	const float MinViewDot = FMath::Cos(FMath::DegreesToRadians(SignificanceViewAngle));
+
+	// Any lure state counts, the spooky lure needs timely positions just as the desirable one
+	const bool bIsLureAvailable = IsValid(PlayerLure);
+	const auto LureRelativeLocation = bIsLureAvailable ? PlayerLure->RelativeTransform.GetLocation() : FVector::ZeroVector;
+
+	for (int32 Index = 0; Index < Swarm.Num(); Index++)
+	{
+		const auto Position = FVector(Swarm.PositionX[Index], Swarm.PositionY[Index], Swarm.PositionZ[Index]);
+
+		if (bIsLureAvailable && FVector::DistSquared(Position, LureRelativeLocation) < FMath::Square(SignificanceLureDistance))
+		{
+			Swarm.Significance[Index] = EFishSignificance::High;
+			continue;
+		}
+
+		const auto ToFish = Position - CameraLocation;
+		const float Distance = ToFish.Length();
+		const bool bIsVisible = Distance < SMALL_NUMBER || FVector::DotProduct(ToFish, CameraForward) >= MinViewDot * Distance;
+
+		Swarm.Significance[Index] = bIsVisible && Distance < SignificanceCameraDistance ?
+			EFishSignificance::High :
+			EFishSignificance::Low;
+	}
+}
+
+void AFishingPond::SimulateSwarm(const float StepTime)
+{
+	FVector LureRelativeLocation;
+	const bool bIsLureAvailable = GetValidLureRelativeLocation(LureRelativeLocation);
+
+	TArray<int32> FishToRemove;
+	Swarm.StorePreviousState();
+	Swarm.Update(StepTime, bIsLureAvailable ? &LureRelativeLocation : nullptr, FishToRemove);
+
+	// Fish actors destroyed from outside of the pond, the clients have none
+	for (int32 Index = 0; Index < SwarmFish.Num() && !Swarm.bIsReplica; Index++)
+	{
+		if (!IsValid(SwarmFish[Index]))
+			FishToRemove.AddUnique(Index);
+	}
+
+	// Descending order, the fish swapped into a removed slot is never removed afterwards
+	FishToRemove.Sort();
+	for (int32 It = FishToRemove.Num() - 1; It >= 0; It--)
+		RemoveSwarmFishAt(FishToRemove[It], true);
+
+	// The fish moved, the grid is rebuilt once and shared by all the queries of the step
+	// The avoidance moves the fish by a fraction of a cell, the grid stays good enough for this step
+	bIsFishGridDirty = true;
+	Swarm.ApplyAvoidance(GetFishGrid(), FishAvoidanceRadius, FishAvoidanceStrength, StepTime);
+	UpdateFishNearLure();
+}
+
+bool AFishingPond::UpdateFishNearLure()
+{
+	// Indices are kept up to date by the removals, only the fish noticing the lure last update are cleared
+	for (const int32 Index : FishNearLure)
+	{
+		if (SwarmFish.IsValidIndex(Index) && IsValid(SwarmFish[Index]))
+			SwarmFish[Index]->SetLureInVicinity(nullptr);
+	}
+
+	FishNearLure.Reset();
+
+	if (!IsValid(PlayerLure))
+		return false;
+
+	const auto LureRelativeLocation = PlayerLure->RelativeTransform.GetLocation();
+
+	GetFishGrid().ForEachInRadius(
+		LureRelativeLocation.X,
+		LureRelativeLocation.Y,
+		MaxLureDetectionRadius,
+		[this](const int32 Index, const float DistanceSquared)
+		{
+			if (DistanceSquared <= FMath::Square(Swarm.GetParams(Index).LureDetectionRadius))
+				FishNearLure.Add(Index);
+		}
 	);
 
-	MockCoro_FishSpawner_Timer = 0.f;
+	if (PlayerLure->IsSpooky())
+	{
+		for (const int32 Index : FishNearLure)
+		{
+			if (IsValid(SwarmFish[Index]))
+				SwarmFish[Index]->SpookFish(PlayerLure->GetActorLocation());
+		}
+
+		FishNearLure.Reset();
+		return false;
+	}
+
+	for (const int32 Index : FishNearLure)
+	{
+		if (IsValid(SwarmFish[Index]))
+			SwarmFish[Index]->SetLureInVicinity(PlayerLure);
+	}
+
+	return FishNearLure.Num() > 0;
+}
+
+void AFishingPond::CreateSilhouetteComponents()
+{
+	SilhouetteLevels = bSilhouettesReadCustomData ? 1 : FMath::Max(SilhouetteOpacityLevels, 2);
+
+	for (const auto* It : FishSpecies)
+	{
+		const auto* FishDefaults = IsValid(It) && IsValid(It->FishClass) ? It->FishClass->GetDefaultObject<AFish>() : nullptr;
+
+		for (int32 Level = 0; Level < SilhouetteLevels; Level++)
+		{
+			// Keeping the indices aligned with the fish species
+			if (!IsValid(FishDefaults) || !IsValid(FishDefaults->Mesh))
+			{
+				SilhouetteComponents.Add(nullptr);
+				continue;
+			}
+
+			auto* Silhouettes = NewObject<UInstancedStaticMeshComponent>(this);
+			Silhouettes->SetStaticMesh(FishDefaults->Mesh);
+			Silhouettes->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			Silhouettes->SetCastShadow(false);
+
+			if (bSilhouettesReadCustomData)
+			{
+				Silhouettes->NumCustomDataFloats = EFishSilhouetteData::Count;
+				Silhouettes->SetMaterial(0, FishDefaults->Material);
+			}
+			else if (IsValid(FishDefaults->Material))
+			{
+				// The fish of the level are drawn with the opacity of the level
+				auto* LevelMaterial = UMaterialInstanceDynamic::Create(FishDefaults->Material, this);
+				LevelMaterial->SetScalarParameterValue("OpacityFactor", static_cast<float>(Level) / (SilhouetteLevels - 1));
+				Silhouettes->SetMaterial(0, LevelMaterial);
+			}
+
+			Silhouettes->SetupAttachment(RootComponent);
+			Silhouettes->RegisterComponent();
+			SilhouetteComponents.Add(Silhouettes);
+		}
+	}
+
+	SilhouetteBuckets.SetNum(SilhouetteComponents.Num());
+	SilhouetteShownCounts.Init(0, SilhouetteComponents.Num());
+}
+
+void AFishingPond::UpdateSilhouettes(const FTransform& PondTransform)
+{
+	for (auto& It : SilhouetteBuckets)
+		It.Reset();
+
+	// One pass over the simulation sorts the fish into the components drawing them
+	for (int32 Index = 0; Index < Swarm.Num(); Index++)
+	{
+		const int32 Level = SilhouetteLevels > 1 ? FMath::RoundToInt(FMath::Clamp(Swarm.Opacity[Index], 0.f, 1.f) * (SilhouetteLevels - 1)) : 0;
+		const int32 Bucket = Swarm.Species[Index] * SilhouetteLevels + Level;
+
+		if (SilhouetteBuckets.IsValidIndex(Bucket))
+			SilhouetteBuckets[Bucket].Add(Index);
+	}
+
+	for (int32 Bucket = 0; Bucket < SilhouetteComponents.Num(); Bucket++)
+	{
+		auto* Silhouettes = SilhouetteComponents[Bucket];
+
+		const int32 Shown = SilhouetteBuckets[Bucket].Num();
+		const int32 LastShown = SilhouetteShownCounts[Bucket];
+
+		// Nothing to draw and nothing to hide
+		if (!IsValid(Silhouettes) || (Shown == 0 && LastShown == 0))
+			continue;
+
+		const auto* SpeciesData = FishSpecies[Bucket / SilhouetteLevels];
+		const auto Scale = FVector(SpeciesData->ScaleHeight, SpeciesData->ScaleWidth, 1.f);
+
+		SilhouetteTransforms.Reset();
+		SilhouetteData.Reset();
+
+		for (const int32 Index : SilhouetteBuckets[Bucket])
+		{
+			auto RelativeTransform = InterpolatedTransforms[Index];
+			RelativeTransform.SetScale3D(Scale);
+
+			// Materials animating on their own wiggle the mesh by world position offset from the wiggle phase
+			if (!bAnimateInMaterials || !bSilhouettesReadCustomData)
+				RelativeTransform.ConcatenateRotation(FRotator(0, Swarm.WiggleYaw[Index], 0).Quaternion());
+
+			SilhouetteTransforms.Add(RelativeTransform * PondTransform);
+
+			if (bSilhouettesReadCustomData)
+			{
+				SilhouetteData.Add(Swarm.Opacity[Index]);
+				SilhouetteData.Add(Swarm.WiggleSineInput[Index]);
+			}
+		}
+
+		// The instances the fish left are hidden, the component only grows when more fish enter than ever before
+		const int32 InstanceCount = Silhouettes->GetInstanceCount();
+		const FTransform HiddenTransform(FQuat::Identity, PondTransform.GetLocation(), FVector::ZeroVector);
+
+		for (int32 Instance = Shown; Instance < FMath::Min(LastShown, InstanceCount); Instance++)
+			SilhouetteTransforms.Add(HiddenTransform);
+
+		if (SilhouetteTransforms.Num() > InstanceCount)
+		{
+			const TArray<FTransform> AddedTransforms(SilhouetteTransforms.GetData() + InstanceCount, SilhouetteTransforms.Num() - InstanceCount);
+			SilhouetteTransforms.SetNum(InstanceCount, false);
+			Silhouettes->AddInstances(AddedTransforms, false, true);
+		}
+
+		const bool bWritesCustomData = bSilhouettesReadCustomData && Shown > 0;
+
+		if (SilhouetteTransforms.Num() > 0)
+			Silhouettes->BatchUpdateInstancesTransforms(0, SilhouetteTransforms, true, !bWritesCustomData, true);
+
+		SilhouetteShownCounts[Bucket] = Shown;
+
+		if (!bWritesCustomData)
+			continue;
+
+		// The render state is marked once, with the last value
+		for (int32 Instance = 0; Instance < Shown; Instance++)
+		{
+			for (int32 Data = 0; Data < EFishSilhouetteData::Count; Data++)
+			{
+				const bool bIsLast = Instance == Shown - 1 && Data == EFishSilhouetteData::Count - 1;
+				Silhouettes->SetCustomDataValue(Instance, Data, SilhouetteData[Instance * EFishSilhouetteData::Count + Data], bIsLast);
+			}
+		}
+	}
+}
+
+void AFishingPond::RemoveSwarmFishAt(const int32 Index, const bool bDestroyActor)
+{
+	auto* Fish = SwarmFish[Index];
+	const int32 LastIndex = SwarmFish.Num() - 1;
+
+	if (HasAuthority())
+		ReplicatedFish.Remove(Swarm.NetId[Index]);
+
+	// The fish near the lure are kept by index, the removed fish leaves them and the last one takes its index
+	if (FishNearLure.RemoveSingleSwap(Index, false) > 0 && bDestroyActor && IsValid(Fish))
+		Fish->SetLureInVicinity(nullptr);
+
+	const int32 MovedNearLure = FishNearLure.Find(LastIndex);
+
+	if (MovedNearLure != INDEX_NONE)
+		FishNearLure[MovedNearLure] = Index;
+
+	Swarm.RemoveAtSwap(Index);
+	SwarmFish.RemoveAtSwap(Index, 1, false);
+	bIsFishGridDirty = true;
+
+	if (SwarmFish.IsValidIndex(Index) && IsValid(SwarmFish[Index]))
+		SwarmFish[Index]->SwarmIndex = Index;
+
+	CurrentFishCount--;
+
+	if (!IsValid(Fish))
+		return;
+
+	Fish->SwarmIndex = INDEX_NONE;
+
+	if (bDestroyActor)
+		UActorPoolSubsystem::ReleaseActor(Fish);
+}
+
+void AFishingPond::CreateRipples()
+{
+	if (RippleResolutionPerQuality.Num() == 0 || RippleExtent <= 0.f)
+		return;
+
+	// Weaker devices run on lower effects quality, the ripples scale with it
+	const int32 Quality = FMath::Clamp(Scalability::GetQualityLevels().EffectsQuality, 0, RippleResolutionPerQuality.Num() - 1);
+	RippleSimulation.Initialize(RippleResolutionPerQuality[Quality], RippleSimulationRate, RippleDamping);
+
+	const int32 Resolution = RippleSimulation.GetResolution();
+	RippleTexture = UTexture2D::CreateTransient(Resolution, Resolution, PF_G8);
+
+	if (!IsValid(RippleTexture))
+		return;
+
+	RippleTexture->SRGB = false;
+	RippleTexture->Filter = TF_Bilinear;
+	RippleTexture->AddressX = TA_Clamp;
+	RippleTexture->AddressY = TA_Clamp;
+	RippleTexture->UpdateResource();
+
+	for (auto* It : { ActualMaterial, TexturePlaneActualMaterial })
+	{
+		if (!IsValid(It))
+			continue;
+
+		It->SetTextureParameterValue("RippleTexture", RippleTexture);
+		It->SetScalarParameterValue("RippleExtent", RippleExtent);
+	}
+}
+
+void AFishingPond::UpdateRipples(const float DeltaTime)
+{
+	if (!IsValid(RippleTexture) || !RippleSimulation.Update(DeltaTime))
+		return;
+
+	// The render thread uploads a copy, the simulation keeps going meanwhile
+	const auto& Pixels = RippleSimulation.GetPixels();
+	const int32 Resolution = RippleSimulation.GetResolution();
+	auto* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, Resolution, Resolution);
+	auto* Data = new uint8[Pixels.Num()];
+	FMemory::Memcpy(Data, Pixels.GetData(), Pixels.Num());
+
+	RippleTexture->UpdateTextureRegions(
+		0,
+		1,
+		Region,
+		Resolution,
+		1,
+		Data,
+		[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+		{
+			delete[] SrcData;
+			delete Regions;
+		}
+	);
 }
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FixedStepClock.h"
+
+FFixedStepClock::FFixedStepClock(const float InRate, const int32 InMaxStepsPerFrame)
+{
+	SetRate(InRate, InMaxStepsPerFrame);
+}
+
+void FFixedStepClock::SetRate(const float InRate, const int32 InMaxStepsPerFrame)
+{
+	StepTime = 1.f / FMath::Max(InRate, 1.f);
+	MaxStepsPerFrame = FMath::Max(InMaxStepsPerFrame, 1);
+	Accumulator = 0.f;
+}
+
+int32 FFixedStepClock::Advance(const float DeltaTime)
+{
+	Accumulator += FMath::Max(DeltaTime, 0.f);
+
+	int32 Steps = FMath::FloorToInt(Accumulator / StepTime);
+	Accumulator -= Steps * StepTime;
+
+	// The time over the catch-up cap is dropped, only the fraction of a step is kept for interpolation
+	if (Steps > MaxStepsPerFrame)
+		Steps = MaxStepsPerFrame;
+
+	Accumulator = FMath::Clamp(Accumulator, 0.f, StepTime * 0.999f);
+	return Steps;
+}
@@ -73,6 +73,14 @@ void AGameplayPlane::BeginPlay()
 		TexturePlaneActualMaterial->SetScalarParameterValue("UVDiameter", 0.0);
 	}
 
+	// The plane mesh is a flat disc, its bounds describe it exactly
+	if (IsValid(StaticMeshComponent->GetStaticMesh()))
+	{
+		const auto MeshBounds = StaticMeshComponent->GetStaticMesh()->GetBounds();
+		DiscCenter = MeshBounds.Origin;
+		DiscRadius = FMath::Max(MeshBounds.BoxExtent.X, MeshBounds.BoxExtent.Y);
+	}
+
 	// Transform and other aspect changes
 	StaticMeshComponent->SetRelativeScale3D(FVector(RadiusXYScale, RadiusXYScale, 1.0f));
 	TexturePlaneMeshComponent->SetRelativeScale3D(FVector(TexturePlaneEdgeSize, TexturePlaneEdgeSize, 1.0f));
@@ -89,69 +97,87 @@ void AGameplayPlane::BeginPlay()
 		ActualMaterial->SetScalarParameterValue("UVDiameter", 0.0);
 		ActualMaterial->SetScalarParameterValue("EmissivityPower", EdgeGlowPower);
 	}
+
+	StartInitialAnimation();
 }
 
-bool AGameplayPlane::MockCoro_InitialAnimation(const float DeltaTime)
+bool AGameplayPlane::IntersectRay(const FVector& RayOrigin, const FVector& RayDirection, const float MaxDistance, FVector& OutHitPosition) const
 {
-	//Function written like a coroutine in case it ever gets support
-	if (MockCoro_InitialAnimation_UVRadius < 1.0f)
-	{
-		MockCoro_InitialAnimation_UVRadius += DeltaTime * GrowthSpeed;
+	if (!CanIntersectRay())
+		return false;
 
-		if (MockCoro_InitialAnimation_UVRadius > 1.0f)
-			MockCoro_InitialAnimation_UVRadius = 1.0f;
+	// In the mesh space the disc is round and flat, the scale of the plane is part of the transform
+	// The direction keeps the inverse scale, so the distance along the ray stays in world units
+	const auto& MeshTransform = StaticMeshComponent->GetComponentTransform();
+	const auto LocalOrigin = MeshTransform.InverseTransformPosition(RayOrigin);
+	const auto LocalDirection = MeshTransform.InverseTransformVector(RayDirection);
 
-		if (IsValid(ActualMaterial))
-			ActualMaterial->SetScalarParameterValue("UVDiameter", MockCoro_InitialAnimation_UVRadius);
+	if (FMath::IsNearlyZero(LocalDirection.Z))
+		return false;
 
-		if (IsValid(TexturePlaneActualMaterial))
-			TexturePlaneActualMaterial->SetScalarParameterValue("UVDiameter", MockCoro_InitialAnimation_UVRadius);
+	const float Distance = (DiscCenter.Z - LocalOrigin.Z) / LocalDirection.Z;
 
+	if (Distance < 0.f || Distance > MaxDistance)
 		return false;
-	}
-	else if (MockCoro_InitialAnimation_CurrentOverallGradient > FinalEdgeOverallGradientIntensity)
-	{
-		MockCoro_InitialAnimation_CurrentOverallGradient -= DeltaTime * (GrowthSpeed / 2);
 
-		if (IsValid(RingActualMaterial))
-			RingActualMaterial->SetScalarParameterValue("OverallGradientIntensity", MockCoro_InitialAnimation_CurrentOverallGradient);
+	const auto LocalHit = LocalOrigin + LocalDirection * Distance;
 
+	if (FMath::Square(LocalHit.X - DiscCenter.X) + FMath::Square(LocalHit.Y - DiscCenter.Y) > FMath::Square(DiscRadius))
 		return false;
-	}
-	else
-	{
-		MockCoro_EndingProcess_CurrentOverallGradient = MockCoro_InitialAnimation_CurrentOverallGradient;
-		return true;
-	}
+
+	OutHitPosition = RayOrigin + RayDirection * Distance;
+	return true;
 }
 
-bool AGameplayPlane::MockCoro_EndingAnimation(const float DeltaTime)
+void AGameplayPlane::StartInitialAnimation()
 {
-	if (MockCoro_EndingProcess_UVRadius > 0.f || MockCoro_EndingProcess_CurrentOverallGradient < 1.f)
-	{
-		MockCoro_EndingProcess_UVRadius -= DeltaTime * GrowthSpeed * 2;
-
-		if (MockCoro_EndingProcess_UVRadius < 0.f)
-			MockCoro_EndingProcess_UVRadius = 0.f;
+	const float Time = GetWorld()->GetTimeSeconds();
+	const float Speed = FMath::Max(GrowthSpeed, KINDA_SMALL_NUMBER);
+
+	// The ring grows first, then its gradient fades to the final intensity
+	DiameterTimeline = FMaterialTimeline(Time, 1.f / Speed, 0.f, 1.f);
+	GradientTimeline = FMaterialTimeline(
+		DiameterTimeline.GetEndTime(),
+		(1.f - FinalEdgeOverallGradientIntensity) / (Speed / 2),
+		1.f,
+		FinalEdgeOverallGradientIntensity
+	);
+
+	if (!bAnimateInMaterials)
+		return;
+
+	DiameterTimeline.WriteTo(ActualMaterial, "UVDiameter");
+	DiameterTimeline.WriteTo(TexturePlaneActualMaterial, "UVDiameter");
+	GradientTimeline.WriteTo(RingActualMaterial, "OverallGradientIntensity");
+}
 
-		if (IsValid(ActualMaterial))
-			ActualMaterial->SetScalarParameterValue("UVDiameter", MockCoro_EndingProcess_UVRadius);
+void AGameplayPlane::StartEndingAnimation()
+{
+	const float Time = GetWorld()->GetTimeSeconds();
+	const float Speed = FMath::Max(GrowthSpeed, KINDA_SMALL_NUMBER) * 2;
 
-		if (IsValid(TexturePlaneActualMaterial))
-			TexturePlaneActualMaterial->SetScalarParameterValue("UVDiameter", MockCoro_EndingProcess_UVRadius);
+	// Continues from wherever the initial animation got to
+	const float CurrentDiameter = DiameterTimeline.Evaluate(Time);
+	const float CurrentGradient = GradientTimeline.Evaluate(Time);
 
-		MockCoro_EndingProcess_CurrentOverallGradient += DeltaTime * GrowthSpeed * 2;
+	DiameterTimeline = FMaterialTimeline(Time, CurrentDiameter / Speed, CurrentDiameter, 0.f);
+	GradientTimeline = FMaterialTimeline(Time, (1.f - CurrentGradient) / Speed, CurrentGradient, 1.f);
 
-		if (MockCoro_EndingProcess_CurrentOverallGradient > 1.f)
-			MockCoro_EndingProcess_CurrentOverallGradient = 1.f;
+	if (!bAnimateInMaterials)
+		return;
 
-		if (IsValid(RingActualMaterial))
-			RingActualMaterial->SetScalarParameterValue("OverallGradientIntensity", MockCoro_EndingProcess_CurrentOverallGradient);
+	DiameterTimeline.WriteTo(ActualMaterial, "UVDiameter");
+	DiameterTimeline.WriteTo(TexturePlaneActualMaterial, "UVDiameter");
+	GradientTimeline.WriteTo(RingActualMaterial, "OverallGradientIntensity");
+}
 
-		return false;
-	}
+void AGameplayPlane::UpdateAnimatedValues()
+{
+	const float Time = GetWorld()->GetTimeSeconds();
 
-	return true;
+	DiameterTimeline.WriteValueTo(ActualMaterial, "UVDiameter", Time);
+	DiameterTimeline.WriteValueTo(TexturePlaneActualMaterial, "UVDiameter", Time);
+	GradientTimeline.WriteValueTo(RingActualMaterial, "OverallGradientIntensity", Time);
 }
 
 // Called every frame
@@ -159,15 +185,23 @@ void AGameplayPlane::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	const float Time = GetWorld()->GetTimeSeconds();
+
+	if (!bAnimateInMaterials && (!bIsInitialised || bIsClosing))
+		UpdateAnimatedValues();
+
 	if (!bIsInitialised)
-		bIsInitialised = MockCoro_InitialAnimation(DeltaTime);
+		bIsInitialised = GradientTimeline.IsFinished(Time);
 
-	if (bIsClosing)
-		if (MockCoro_EndingAnimation(DeltaTime))
-			GWorld->DestroyActor(this);
+	if (bIsClosing && DiameterTimeline.IsFinished(Time) && GradientTimeline.IsFinished(Time))
+		GWorld->DestroyActor(this);
 }
 
 void AGameplayPlane::OnDisplayModeChanged(const TEnumAsByte<EDisplayMode> NewMode)
 {
+	if (bIsClosing)
+		return;
+
 	bIsClosing = true;
+	StartEndingAnimation();
 }
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GestureRecognizer.h"
+
+FTouchGesture FGestureRecognizer::OnTouchPressed(const ETouchIndex::Type Finger, const FVector2D& Position, const double Time)
+{
+	if (Finger >= ETouchIndex::MAX_TOUCHES || Touches[Finger].bIsDown)
+		return FTouchGesture();
+
+	auto& Touch = Touches[Finger];
+	Touch.bIsDown = true;
+	Touch.StartPosition = Position;
+	Touch.Position = Position;
+	Touch.StartTime = Time;
+	TouchCount++;
+
+	// A second finger ends the drag and starts the pinch
+	if (TouchCount == 2)
+	{
+		bIsDragging = false;
+		bWasPinching = true;
+		StorePinchBase();
+	}
+
+	return FTouchGesture();
+}
+
+FTouchGesture FGestureRecognizer::OnTouchMoved(const ETouchIndex::Type Finger, const FVector2D& Position, const double Time)
+{
+	FTouchGesture Gesture;
+
+	if (Finger >= ETouchIndex::MAX_TOUCHES || !Touches[Finger].bIsDown)
+		return Gesture;
+
+	auto& Touch = Touches[Finger];
+	Touch.Position = Position;
+
+	int32 First, Second;
+
+	if (FindPinchFingers(First, Second))
+	{
+		// Only the fingers of the pinch count, the others rest on the screen
+		if (Finger != First && Finger != Second)
+			return Gesture;
+
+		const auto Between = Touches[Second].Position - Touches[First].Position;
+		const float Distance = Between.Size();
+		const float Angle = FMath::RadiansToDegrees(FMath::Atan2(Between.Y, Between.X));
+
+		Gesture.Type = ETouchGesture::Pinch;
+		Gesture.Position = (Touches[First].Position + Touches[Second].Position) * 0.5f;
+		Gesture.Scale = PinchDistance > KINDA_SMALL_NUMBER ? Distance / PinchDistance : 1.f;
+		Gesture.Rotation = FRotator::NormalizeAxis(Angle - PinchAngle);
+
+		PinchDistance = Distance;
+		PinchAngle = Angle;
+		return Gesture;
+	}
+
+	// After a pinch the remaining finger does nothing until it is lifted
+	if (bWasPinching)
+		return Gesture;
+
+	if (!bIsDragging && FVector2D::DistSquared(Touch.StartPosition, Position) > FMath::Square(DragDistance))
+		bIsDragging = true;
+
+	if (bIsDragging)
+	{
+		Gesture.Type = ETouchGesture::Drag;
+		Gesture.Position = Position;
+	}
+
+	return Gesture;
+}
+
+FTouchGesture FGestureRecognizer::OnTouchReleased(const ETouchIndex::Type Finger, const FVector2D& Position, const double Time)
+{
+	FTouchGesture Gesture;
+
+	if (Finger >= ETouchIndex::MAX_TOUCHES || !Touches[Finger].bIsDown)
+		return Gesture;
+
+	auto& Touch = Touches[Finger];
+	Touch.bIsDown = false;
+	TouchCount--;
+
+	if (!bWasPinching && !bIsDragging && Time - Touch.StartTime <= TapTime)
+	{
+		Gesture.Type = ETouchGesture::Tap;
+		Gesture.Position = Position;
+	}
+
+	// The pinch goes on with the next two fingers, if any
+	if (TouchCount >= 2)
+		StorePinchBase();
+
+	if (TouchCount == 0)
+	{
+		bIsDragging = false;
+		bWasPinching = false;
+	}
+
+	return Gesture;
+}
+
+void FGestureRecognizer::Reset()
+{
+	for (auto& It : Touches)
+		It = FTouchPoint();
+
+	TouchCount = 0;
+	bIsDragging = false;
+	bWasPinching = false;
+}
+
+bool FGestureRecognizer::GetDrag(ETouchIndex::Type& OutFinger, FVector2D& OutPosition) const
+{
+	if (!bIsDragging || TouchCount != 1)
+		return false;
+
+	for (int32 Index = 0; Index < ETouchIndex::MAX_TOUCHES; Index++)
+	{
+		if (!Touches[Index].bIsDown)
+			continue;
+
+		OutFinger = static_cast<ETouchIndex::Type>(Index);
+		OutPosition = Touches[Index].Position;
+		return true;
+	}
+
+	return false;
+}
+
+bool FGestureRecognizer::FindPinchFingers(int32& OutFirst, int32& OutSecond) const
+{
+	OutFirst = INDEX_NONE;
+	OutSecond = INDEX_NONE;
+
+	for (int32 Index = 0; Index < ETouchIndex::MAX_TOUCHES; Index++)
+	{
+		if (!Touches[Index].bIsDown)
+			continue;
+
+		if (OutFirst == INDEX_NONE)
+		{
+			OutFirst = Index;
+			continue;
+		}
+
+		OutSecond = Index;
+		return true;
+	}
+
+	return false;
+}
+
+void FGestureRecognizer::StorePinchBase()
+{
+	int32 First, Second;
+
+	if (!FindPinchFingers(First, Second))
+		return;
+
+	const auto Between = Touches[Second].Position - Touches[First].Position;
+	PinchDistance = Between.Size();
+	PinchAngle = FMath::RadiansToDegrees(FMath::Atan2(Between.Y, Between.X));
+}
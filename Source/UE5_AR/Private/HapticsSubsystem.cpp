@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HapticsSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+
+void UHapticsSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceUpdate += DeltaTime;
+
+	// The highest priority with a request decides, lower ones are ignored
+	float Intensity = 0.f;
+
+	for (int32 Priority = EHapticPriority::Count - 1; Priority >= 0; Priority--)
+	{
+		if (RequestedIntensity[Priority] > 0.f)
+		{
+			Intensity = RequestedIntensity[Priority];
+			break;
+		}
+	}
+
+	for (auto& It : RequestedIntensity)
+		It = 0.f;
+
+	auto* Player = UGameplayStatics::GetPlayerController(this, 0);
+
+	if (!IsValid(Player))
+		return;
+
+	if (Intensity <= 0.f)
+	{
+		if (FeedbackHandle != 0)
+			Player->PlayDynamicForceFeedback(0.f, 0.f, true, true, true, true, EDynamicForceFeedbackAction::Stop, FeedbackHandle);
+
+		FeedbackHandle = 0;
+		SentIntensity = 0.f;
+		return;
+	}
+
+	const bool bIsRunningOut = TimeSinceUpdate >= FeedbackDuration - MinUpdateInterval;
+	const bool bHasChanged = FMath::Abs(Intensity - SentIntensity) > IntensityTolerance;
+
+	if (FeedbackHandle != 0 && !bIsRunningOut && (!bHasChanged || TimeSinceUpdate < MinUpdateInterval))
+		return;
+
+	// Restarting with the existing handle reuses the running feedback
+	FeedbackHandle = Player->PlayDynamicForceFeedback(
+		Intensity,
+		FeedbackDuration,
+		true,
+		true,
+		true,
+		true,
+		EDynamicForceFeedbackAction::Start,
+		FeedbackHandle
+	);
+
+	SentIntensity = Intensity;
+	TimeSinceUpdate = 0.f;
+}
+
+TStatId UHapticsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHapticsSubsystem, STATGROUP_Tickables);
+}
+
+void UHapticsSubsystem::RequestForceFeedback(const float Intensity, const EHapticPriority::Type Priority)
+{
+	RequestedIntensity[Priority] = FMath::Max(RequestedIntensity[Priority], FMath::Clamp(Intensity, 0.f, 1.f));
+}
+
+void UHapticsSubsystem::RequestForceFeedback(const UObject* WorldContext, const float Intensity, const EHapticPriority::Type Priority)
+{
+	const auto* World = IsValid(WorldContext) ? WorldContext->GetWorld() : nullptr;
+	auto* Haptics = IsValid(World) ? World->GetSubsystem<UHapticsSubsystem>() : nullptr;
+
+	if (IsValid(Haptics))
+		Haptics->RequestForceFeedback(Intensity, Priority);
+}
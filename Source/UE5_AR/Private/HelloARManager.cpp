@@ -8,6 +8,7 @@
 #include "ARBlueprintLibrary.h"
 #include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
 #include "CustomGameMode.h"
+#include "ActorPoolSubsystem.h"
 #include "ProceduralMeshComponent.h"
 
 // Sets default values
@@ -46,6 +47,10 @@ void AHelloARManager::BeginPlay()
 
 	//Start the AR Session
 	UARBlueprintLibrary::StartARSession(Config);
+
+	// Planes get found and lost all the time while scanning
+	if (auto* Pool = GetWorld()->GetSubsystem<UActorPoolSubsystem>())
+		Pool->Prewarm(AARPlaneActor::StaticClass(), PrewarmedPlaneActors);
 }
 
 // Called every frame
@@ -133,7 +138,7 @@ void AHelloARManager::UpdatePlaneActors()
 			//Check if plane is subsumed
 			if (IsValid(It) && IsValid(It->GetSubsumedBy()) && It->GetSubsumedBy()->IsValidLowLevel())
 			{
-				GetWorld()->DestroyActor(CurrentPActor);
+				UActorPoolSubsystem::ReleaseActor(CurrentPActor);
 				PlaneActors.Remove(It);
 				GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Emerald, TEXT("Plane subsummed"));
 				break;
@@ -149,7 +154,7 @@ void AHelloARManager::UpdatePlaneActors()
 						break;
 						//If not tracking destroy the actor and remove from map of actors
 					case EARTrackingState::StoppedTracking:
-						GetWorld()->DestroyActor(CurrentPActor);
+						UActorPoolSubsystem::ReleaseActor(CurrentPActor);
 						PlaneActors.Remove(It);
 						GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Emerald, TEXT("Plane stopped being tracked"));
 						break;
@@ -179,16 +184,10 @@ void AHelloARManager::UpdatePlaneActors()
 	}
 }
 
-//Simple spawn function for the tracked AR planes
+//Simple spawn function for the tracked AR planes, reuses pooled planes when available
 AARPlaneActor* AHelloARManager::SpawnPlaneActor()
 {
-	const FActorSpawnParameters SpawnInfo;
-	const FRotator MyRot(0, 0, 0);
-	const FVector MyLoc(0, 0, 0);
-
-	AARPlaneActor* CustomPlane = GetWorld()->SpawnActor<AARPlaneActor>(MyLoc, MyRot, SpawnInfo);
-
-	return CustomPlane;
+	return Cast<AARPlaneActor>(UActorPoolSubsystem::AcquireActor(this, AARPlaneActor::StaticClass()));
 }
 
 //Gets the colour to set the plane to when its spawned
@@ -199,18 +198,15 @@ FColor AHelloARManager::GetPlaneColor(int Index)
 
 void AHelloARManager::ResetARCoreSession()
 {
-	//Get all actors in the level and destroy them as well as emptying the respective arrays
-	TArray<AActor*> Planes;
+	//Release all the plane actors into the pool as well as emptying the respective arrays
 	auto Geometries = UARBlueprintLibrary::GetAllGeometriesByClass<UARPlaneGeometry>();
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AARPlaneActor::StaticClass(), Planes);
 
 	for (auto It : Geometries)
 		It->RemoveFromRoot();
 
-	for (auto& It : Planes)
-		GWorld->DestroyActor(It);
+	for (auto& It : PlaneActors)
+		UActorPoolSubsystem::ReleaseActor(It.Value);
 	
-	Planes.Empty();
 	PlaneActors.Empty();
 
 }
@@ -20,16 +20,26 @@ void AHousePlane::BeginPlay()
 
 	if (IsValid(DefaultHouse))
 		HouseMeshComponent->SetStaticMesh(DefaultHouse);
+
+	StartHouseIntroAnimation();
 }
 
 void AHousePlane::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (!bIsHouseInitialized && MockCoro_HouseIntroAnimation(DeltaTime))
+	if (!bIsHouseInitialized)
 	{
-		 bIsHouseInitialized = true;
-		 LoadLayout();
+		const float Time = GetWorld()->GetTimeSeconds();
+
+		if (!bAnimateInMaterials)
+			UpdateHouseIntroTransform(Time);
+
+		if (HouseIntroTimeline.IsFinished(Time))
+		{
+			bIsHouseInitialized = true;
+			LoadLayout();
+		}
 	}
 
 	AutosaveTimer += DeltaTime;
@@ -70,6 +80,15 @@ void AHousePlane::OnDrag(const FVector& TouchPositionWorld)
 	OnTouched(TouchPositionWorld);
 }
 
+void AHousePlane::Suspend()
+{
+	// Before the intro is over the placed objects are not loaded yet, saving would lose them
+	if (bIsHouseInitialized)
+		StoreLayout();
+
+	Super::Suspend();
+}
+
 bool AHousePlane::CanAddMeshToUI()
 {
 	auto* Player = IsValid(UGameplayStatics::GetPlayerPawn(this, 0)) ?
@@ -82,31 +101,44 @@ bool AHousePlane::CanAddMeshToUI()
 	return false;
 }
 
-bool AHousePlane::MockCoro_HouseIntroAnimation(const float DeltaTime)
+void AHousePlane::StartHouseIntroAnimation()
 {
-	if (!(MockCoro_HouseIntroAnimation_Completion > 0.f))
+	HouseIntroTimeline = FMaterialTimeline(GetWorld()->GetTimeSeconds(), AnimationDuration, 1.f, 0.f);
+	HouseMeshComponent->SetVisibility(true);
+
+	if (!bAnimateInMaterials)
 	{
-		auto CurrentRelativeLocation = HouseMeshComponent->GetRelativeLocation();
-		CurrentRelativeLocation.Z = InitialHouseRelativeHeightOffset;
-		HouseMeshComponent->SetRelativeLocation(CurrentRelativeLocation);
-		HouseMeshComponent->SetRelativeRotation(FRotator(0, 90 + InitialHouseRelativeRotationOffset, 0));
-		HouseMeshComponent->SetVisibility(true);
+		UpdateHouseIntroTransform(HouseIntroTimeline.StartTime);
+		return;
 	}
 
-	MockCoro_HouseIntroAnimation_Completion += DeltaTime / AnimationDuration;
+	// The mesh stays at its final transform, the world position offset of the materials lifts and turns it
+	auto FinalRelativeLocation = HouseMeshComponent->GetRelativeLocation();
+	FinalRelativeLocation.Z = 0.f;
+	HouseMeshComponent->SetRelativeLocation(FinalRelativeLocation);
+	HouseMeshComponent->SetRelativeRotation(FRotator(0, 90, 0));
+
+	for (int32 Slot = 0; Slot < HouseMeshComponent->GetNumMaterials(); Slot++)
+	{
+		auto* HouseMaterial = HouseMeshComponent->CreateDynamicMaterialInstance(Slot);
+
+		if (!IsValid(HouseMaterial))
+			continue;
 
-	if (MockCoro_HouseIntroAnimation_Completion > 1.f)
-		MockCoro_HouseIntroAnimation_Completion = 1.f;
+		HouseMaterial->SetScalarParameterValue("HouseIntroHeightOffset", InitialHouseRelativeHeightOffset);
+		HouseMaterial->SetScalarParameterValue("HouseIntroRotationOffset", InitialHouseRelativeRotationOffset);
+		HouseIntroTimeline.WriteTo(HouseMaterial, "HouseIntro");
+		HouseActualMaterials.Add(HouseMaterial);
+	}
+}
 
-	float RelativeTimeLeft = 1.f - MockCoro_HouseIntroAnimation_Completion;
-	float CurrentHeight = RelativeTimeLeft * InitialHouseRelativeHeightOffset;
-	float CurrentRotation = RelativeTimeLeft * InitialHouseRelativeRotationOffset;
+void AHousePlane::UpdateHouseIntroTransform(const float Time)
+{
+	const float RelativeTimeLeft = HouseIntroTimeline.Evaluate(Time);
 	auto CurrentRelativeLocation = HouseMeshComponent->GetRelativeLocation();
-	CurrentRelativeLocation.Z = CurrentHeight;
+	CurrentRelativeLocation.Z = RelativeTimeLeft * InitialHouseRelativeHeightOffset;
 	HouseMeshComponent->SetRelativeLocation(CurrentRelativeLocation);
-	HouseMeshComponent->SetRelativeRotation(FRotator(0, 90 + CurrentRotation, 0));
-
-	return MockCoro_HouseIntroAnimation_Completion >= 1.f;
+	HouseMeshComponent->SetRelativeRotation(FRotator(0, 90 + RelativeTimeLeft * InitialHouseRelativeRotationOffset, 0));
 }
 
 void AHousePlane::LoadLayout()
@@ -120,12 +152,12 @@ void AHousePlane::LoadLayout()
 	for(auto& It : StoredLayout)
 	{
 		auto SpawnTransform = FTransform(It.GeneralRelativeTransform * PinComponent->GetLocalToWorldTransform());
-		auto SpawnedActor = GetWorld()->SpawnActor(It.Class, &SpawnTransform);
+		auto SpawnedActor = UActorPoolSubsystem::AcquireActor(this, It.Class, SpawnTransform);
 		auto SpawnedPlaceable = Cast<APlaceableActor>(SpawnedActor);
 
 		if (!IsValid(SpawnedPlaceable) || !IsValid(PinComponent))
 		{
-			GetWorld()->DestroyActor(SpawnedActor);
+			UActorPoolSubsystem::ReleaseActor(SpawnedActor);
 			continue;
 		}
 
@@ -154,7 +186,7 @@ void AHousePlane::StoreLayout()
 
 		const auto* ActorToStore = Cast<APlaceableActor>(It);
 
-		if (!IsValid(ActorToStore) || ActorToStore->GetIsUIMember())
+		if (!IsValid(ActorToStore) || ActorToStore->GetIsUIMember() || ActorToStore->IsInPool() || ActorToStore->IsSuspended())
 			continue;
 
 		FLayoutData ArrayElement;
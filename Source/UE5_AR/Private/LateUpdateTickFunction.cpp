@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LateUpdateTickFunction.h"
+#include "GameFramework/Actor.h"
+
+FLateUpdateTickFunction::FLateUpdateTickFunction()
+{
+	// The camera managers are updated between the post physics and the post update work groups
+	TickGroup = TG_PostUpdateWork;
+	bCanEverTick = true;
+	bStartWithTickEnabled = true;
+}
+
+void FLateUpdateTickFunction::Register(AActor* Owner, TFunction<void(float)>&& InUpdate)
+{
+	if (!IsValid(Owner) || IsTickFunctionRegistered())
+		return;
+
+	Target = Owner;
+	Update = MoveTemp(InUpdate);
+
+	// The late work follows the regular tick of the owner
+	AddPrerequisite(Owner, Owner->PrimaryActorTick);
+	RegisterTickFunction(Owner->GetLevel());
+}
+
+void FLateUpdateTickFunction::Unregister()
+{
+	if (IsTickFunctionRegistered())
+		UnRegisterTickFunction();
+
+	Target = nullptr;
+	Update = nullptr;
+}
+
+void FLateUpdateTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	// An actor with its tick disabled, such as a pooled one, skips the late work too
+	const auto* Owner = Target.Get();
+
+	if (!IsValid(Owner) || !Owner->IsActorTickEnabled() || !Update)
+		return;
+
+	Update(DeltaTime);
+}
+
+FString FLateUpdateTickFunction::DiagnosticMessage()
+{
+	return Target.IsValid() ? Target->GetFullName() + TEXT("[LateUpdateTick]") : TEXT("[LateUpdateTick]");
+}
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MaterialTimeline.h"
+
+#include "Materials/MaterialInstanceDynamic.h"
+
+FMaterialTimeline::FMaterialTimeline(const float InStartTime, const float InDuration, const float InFrom, const float InTo, const float InExponent)
+	: StartTime(InStartTime)
+	, Duration(InDuration)
+	, From(InFrom)
+	, To(InTo)
+	, Exponent(InExponent)
+{
+}
+
+float FMaterialTimeline::Evaluate(const float Time) const
+{
+	if (Duration <= 0.f)
+		return Time >= StartTime ? To : From;
+
+	const float Alpha = FMath::Clamp((Time - StartTime) / Duration, 0.f, 1.f);
+	return FMath::Lerp(From, To, FMath::Pow(Alpha, Exponent));
+}
+
+void FMaterialTimeline::WriteTo(UMaterialInstanceDynamic* Material, const FName& Parameter) const
+{
+	if (!IsValid(Material))
+		return;
+
+	const auto BaseName = Parameter.ToString();
+
+	// A zero duration would divide by zero in the material, a tiny one jumps to the end just the same
+	Material->SetScalarParameterValue(*(BaseName + TEXT("StartTime")), StartTime);
+	Material->SetScalarParameterValue(*(BaseName + TEXT("Duration")), FMath::Max(Duration, KINDA_SMALL_NUMBER));
+	Material->SetScalarParameterValue(*(BaseName + TEXT("From")), From);
+	Material->SetScalarParameterValue(*(BaseName + TEXT("To")), To);
+	Material->SetScalarParameterValue(*(BaseName + TEXT("Exponent")), Exponent);
+}
+
+void FMaterialTimeline::WriteValueTo(UMaterialInstanceDynamic* Material, const FName& Parameter, const float Time) const
+{
+	if (IsValid(Material))
+		Material->SetScalarParameterValue(Parameter, Evaluate(Time));
+}
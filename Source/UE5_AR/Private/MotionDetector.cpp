@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MotionDetector.h"
+
+void FMotionDetector::AddPose(const double Time, const FTransform& CameraTransform)
+{
+	bHasSuddenMovement = false;
+	bHasSuddenRotation = false;
+
+	// Poses of the same moment carry no motion
+	if (Count > 0 && Time <= GetSample(0).Time)
+		return;
+
+	const double PreviousTime = Count > 0 ? GetSample(0).Time : Time;
+
+	Head = (Head + 1) % Capacity;
+	Count = FMath::Min(Count + 1, Capacity);
+	Samples[Head].Time = Time;
+	Samples[Head].Location = CameraTransform.GetLocation();
+	Samples[Head].Rotation = CameraTransform.GetRotation();
+
+	// The oldest pose still inside the window, or the one just before it if the frames are longer than the window
+	int32 Oldest = 1;
+
+	while (Oldest + 1 < Count && Time - GetSample(Oldest).Time < DetectionWindow)
+		Oldest++;
+
+	if (Oldest >= Count)
+		return;
+
+	const auto& Start = GetSample(Oldest);
+	const auto& End = GetSample(0);
+	const float Span = static_cast<float>(End.Time - Start.Time);
+
+	// Measured over the window, the same motion gives the same speed at any frame rate
+	const FVector MeasuredVelocity = (End.Location - Start.Location) / Span;
+
+	// The angle between the poses has no sign to cancel out, unlike the sum of the rotator components
+	FQuat Turn = End.Rotation * Start.Rotation.Inverse();
+
+	if (Turn.W < 0.f)
+		Turn = Turn * -1.f;
+
+	const FVector MeasuredAngularVelocity = Turn.GetRotationAxis() * FMath::RadiansToDegrees(Turn.GetAngle()) / Span;
+
+	// High-pass, the slow motion follows the measured one with the time constant
+	const float Blend = 1.f - FMath::Exp(-static_cast<float>(Time - PreviousTime) / HighPassTime);
+	Velocity = MeasuredVelocity - SlowVelocity;
+	const FVector AngularVelocity = MeasuredAngularVelocity - SlowAngularVelocity;
+	SlowVelocity += (MeasuredVelocity - SlowVelocity) * Blend;
+	SlowAngularVelocity += (MeasuredAngularVelocity - SlowAngularVelocity) * Blend;
+	WindowRotation = Turn.Rotator();
+
+	// Hysteresis, one detection per jerk
+	const float Speed = Velocity.Length();
+	const float AngularSpeed = AngularVelocity.Length();
+
+	bHasSuddenMovement = bIsMovementArmed && Speed > MovementThreshold;
+	bIsMovementArmed = bHasSuddenMovement ? false : bIsMovementArmed || Speed < MovementThreshold * ReleaseRatio;
+
+	bHasSuddenRotation = bIsRotationArmed && AngularSpeed > RotationThreshold;
+	bIsRotationArmed = bHasSuddenRotation ? false : bIsRotationArmed || AngularSpeed < RotationThreshold * ReleaseRatio;
+}
+
+void FMotionDetector::Reset()
+{
+	Head = 0;
+	Count = 0;
+	SlowVelocity = FVector::ZeroVector;
+	SlowAngularVelocity = FVector::ZeroVector;
+	Velocity = FVector::ZeroVector;
+	WindowRotation = FRotator::ZeroRotator;
+	bHasSuddenMovement = false;
+	bHasSuddenRotation = false;
+	bIsMovementArmed = true;
+	bIsRotationArmed = true;
+}
+
+void FMotionDetector::SetThresholds(const float InMovementThreshold, const float InRotationThreshold)
+{
+	MovementThreshold = InMovementThreshold;
+	RotationThreshold = InRotationThreshold;
+}
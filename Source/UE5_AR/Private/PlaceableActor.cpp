@@ -6,6 +6,7 @@
 #include "CustomARPawn.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Camera/CameraComponent.h"
+#include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
 
 // Sets default values
 APlaceableActor::APlaceableActor()
@@ -40,7 +41,8 @@ void APlaceableActor::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (IsValid(SpawnPuff))
+	// Pre-warmed actors are not really spawned yet, the effects play once acquired from the pool
+	if (IsValid(SpawnPuff) && !bIsInPool)
 		UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, SpawnPuff, GetActorLocation());
 
 	if (IsValid(Mesh))
@@ -58,7 +60,7 @@ void APlaceableActor::BeginPlay()
 	else
 		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, TEXT("No Dynamic material (APlaceableActor::BeginPlay())"));
 
-	if (IsValid(SpawnPuff))
+	if (IsValid(SpawnPuff) && !bIsInPool)
 		UNiagaraFunctionLibrary::SpawnSystemAtLocation(
 			this, 
 			SpawnPuff, 
@@ -66,6 +68,12 @@ void APlaceableActor::BeginPlay()
 			FRotator(0, 0, 0),
 			StaticMeshComponent->GetComponentScale()
 		);
+
+	InitialMeshTransform = StaticMeshComponent->GetRelativeTransform();
+
+	// The camera pose of the frame is tracked by the player, camera relative work has to come after it
+	if (auto* Player = UGameplayStatics::GetPlayerPawn(this, 0))
+		AddTickPrerequisiteActor(Player);
 }
 
 // Called every frame
@@ -99,7 +107,69 @@ void APlaceableActor::Tick(float DeltaTime)
 
 void APlaceableActor::OnDisplayModeChanged(const TEnumAsByte<EDisplayMode> NewMode)
 {
-	GWorld->DestroyActor(this);
+	UActorPoolSubsystem::ReleaseActor(this);
+}
+
+void APlaceableActor::OnAcquiredFromPool()
+{
+	bIsInPool = false;
+
+	if (IsValid(SpawnPuff))
+		UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+			this,
+			SpawnPuff,
+			GetActorLocation(),
+			FRotator(0, 0, 0),
+			StaticMeshComponent->GetComponentScale()
+		);
+}
+
+void APlaceableActor::OnReleasedToPool()
+{
+	Deselect();
+
+	if (bIsUIMember)
+		SetAsUIMember(false, UIPlayer);
+
+	bIsInPool = true;
+	bIsSuspended = false;
+	PinComponent = nullptr;
+	RelativeTransform = FTransform::Identity;
+	StaticMeshComponent->SetVisibility(true);
+	StaticMeshComponent->SetRelativeTransform(InitialMeshTransform);
+
+	// Subclasses can swap the material for their own, the one applied on the mesh is the original
+	auto* MeshMaterial = Cast<UMaterialInstanceDynamic>(StaticMeshComponent->GetMaterial(0));
+	if (IsValid(MeshMaterial))
+		ActualMaterial = MeshMaterial;
+}
+
+void APlaceableActor::Suspend()
+{
+	if (bIsSuspended)
+		return;
+
+	Deselect();
+
+	bWasHiddenBeforeSuspend = IsHidden();
+	bWasCollisionEnabledBeforeSuspend = GetActorEnableCollision();
+	bWasTickEnabledBeforeSuspend = IsActorTickEnabled();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	bIsSuspended = true;
+}
+
+void APlaceableActor::Resume()
+{
+	if (!bIsSuspended)
+		return;
+
+	SetActorHiddenInGame(bWasHiddenBeforeSuspend);
+	SetActorEnableCollision(bWasCollisionEnabledBeforeSuspend);
+	SetActorTickEnabled(bWasTickEnabledBeforeSuspend);
+	bIsSuspended = false;
 }
 
 void APlaceableActor::Select()
@@ -173,9 +243,15 @@ void APlaceableActor::SetAsUIMember(const bool State, ACustomARPawn* CurrentUIPl
 		UIObjectCameraOffset = RelativeCameraOffset;
 		CurrentUIPlayer->UIMembers.AddUnique(this);
 		UIPlayer = CurrentUIPlayer;
+		bIsUITransformUpToDate = false;
+
+		// Attached to the camera, the member follows the camera pose the frame is rendered with
+		AttachToComponent(UIPlayer->CameraComponent, FAttachmentTransformRules::KeepWorldTransform);
+		AddTickPrerequisiteActor(UIPlayer);
 	}
 	else
 	{
+		DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
 		UIPlayer->UIMembers.RemoveSingle(this);
 		UIPlayer = nullptr;
 		RelativeTransform.SetRotation(FRotator().Quaternion());
@@ -187,6 +263,10 @@ void APlaceableActor::UIMemberUpdate(const float DeltaTime)
 	if (!UIPlayer)
 		return;
 
+	// The camera moves the member, only the spin is left to update
+	if (bIsUITransformUpToDate && PlacingActorAngularVelocity == 0.f)
+		return;
+
 	// Rotate around in camera relative space
 	auto PlacingActorRotation = RelativeTransform.GetRotation().Rotator();
 	PlacingActorRotation.Yaw += DeltaTime * PlacingActorAngularVelocity;
@@ -194,7 +274,9 @@ void APlaceableActor::UIMemberUpdate(const float DeltaTime)
 	RelativeTransform.SetLocation(UIObjectCameraOffset);
 
 	// Apply relative to the camera
-	const auto& CameraTransform = UIPlayer->CameraComponent->GetComponentTransform();
-	SetActorTransform(RelativeTransform * CameraTransform);
-	SetActorScale3D(FVector(0.25, 0.25, 0.25));
+	// The scale is part of the same update, the components are moved once
+	auto UITransform = RelativeTransform;
+	UITransform.SetScale3D(FVector(0.25, 0.25, 0.25));
+	SetActorRelativeTransform(UITransform);
+	bIsUITransformUpToDate = true;
 }
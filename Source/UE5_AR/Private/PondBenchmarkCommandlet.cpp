@@ -0,0 +1,392 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PondBenchmarkCommandlet.h"
+
+#include <atomic>
+#include "CustomARPawn.h"
+#include "Fish.h"
+#include "FishingLure.h"
+#include "FishingPond.h"
+#include "Camera/CameraComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPondBenchmark, Log, All);
+
+//! @brief Allocator forwarding to the engine allocator and counting the calls, installed only for the measured frames
+class FCountingMalloc final : public FMalloc
+{
+public:
+
+	explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		Allocations++;
+		return Inner->Malloc(Count, Alignment);
+	}
+
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+	{
+		Allocations++;
+		return Inner->TryMalloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		// Growing from nothing allocates, shrinking to nothing frees
+		if (!Original)
+			Allocations++;
+		else if (Count == 0)
+			Frees++;
+		else
+			Reallocations++;
+
+		return Inner->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override
+	{
+		if (Original)
+			Frees++;
+
+		Inner->Free(Original);
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+	virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+	virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+	virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+	virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+	virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+	virtual void UpdateStats() override { Inner->UpdateStats(); }
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+
+	//! Calls counted since the allocator was created, from all threads
+	std::atomic<uint64> Allocations{ 0 };
+	std::atomic<uint64> Reallocations{ 0 };
+	std::atomic<uint64> Frees{ 0 };
+
+private:
+
+	//! The engine allocator doing the work
+	FMalloc* Inner = nullptr;
+};
+
+UPondBenchmarkCommandlet::UPondBenchmarkCommandlet()
+{
+	LogToConsole = true;
+	HelpDescription = TEXT("Measures the cost of the fishing pond without a device, writes the results as JSON");
+	HelpUsage = TEXT("UnrealEditor-Cmd UE5_AR.uproject -run=PondBenchmark -nullrhi [-Fish=10 -Frames=3000 -Output=Path.json]");
+}
+
+int32 UPondBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString PondClassPath = TEXT("/Game/Blueprints/BP_FishingPond.BP_FishingPond_C");
+	FString PawnClassPath = TEXT("/Game/Blueprints/BP_CustomARPawn.BP_CustomARPawn_C");
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks/PondBenchmark.json");
+	int32 FishPerSpecies = 10;
+	int32 Frames = 3000;
+	int32 WarmupFrames = 60;
+	int32 Seed = 0;
+
+	FParse::Value(*Params, TEXT("Pond="), PondClassPath);
+	FParse::Value(*Params, TEXT("Pawn="), PawnClassPath);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("Fish="), FishPerSpecies);
+	FParse::Value(*Params, TEXT("Frames="), Frames);
+	FParse::Value(*Params, TEXT("Warmup="), WarmupFrames);
+	FParse::Value(*Params, TEXT("DeltaTime="), DeltaTime);
+	FParse::Value(*Params, TEXT("Tug="), TugSpeed);
+	FParse::Value(*Params, TEXT("Jerk="), JerkSpeed);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+
+	auto* PondClass = LoadClass<AFishingPond>(nullptr, *PondClassPath);
+	auto* PawnClass = LoadClass<ACustomARPawn>(nullptr, *PawnClassPath);
+
+	if (!IsValid(PondClass))
+	{
+		UE_LOG(LogPondBenchmark, Error, TEXT("Could not load the pond class %s"), *PondClassPath);
+		return 1;
+	}
+
+	if (!IsValid(PawnClass))
+		PawnClass = ACustomARPawn::StaticClass();
+
+	// The script is the same every run, so are the random positions of the pond
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+
+	// A bare game world, the actors get BeginPlay without a game mode and the AR session is never started
+	auto* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("PondBenchmark"));
+	auto& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	auto* PreviousWorld = GWorld;
+	GWorld = World;
+
+	World->InitializeActorsForPlay(FURL());
+	World->GetWorldSettings()->NotifyBeginPlay();
+
+	// The fish and the lure read the camera through the first player pawn
+	auto* Controller = World->SpawnActor<APlayerController>();
+	auto* Player = World->SpawnActor<ACustomARPawn>(PawnClass);
+
+	if (!IsValid(Controller) || !IsValid(Player))
+	{
+		UE_LOG(LogPondBenchmark, Error, TEXT("Could not spawn the player"));
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		GWorld = PreviousWorld;
+		return 1;
+	}
+
+	Controller->Possess(Player);
+	UpdateCamera(Player, 0);
+
+	// No AR pin without an AR session, the pond stands at the origin and the relative positions are world positions
+	auto* Pond = World->SpawnActorDeferred<AFishingPond>(PondClass, FTransform::Identity);
+	const int32 TotalFish = FishPerSpecies * Pond->FishSpecies.Num();
+
+	// The population stays at the requested size, the fish that leave are replaced
+	Pond->MaxFish = FMath::Max(TotalFish, 1);
+	Pond->MinFish = Pond->MaxFish;
+	Pond->FinishSpawning(FTransform::Identity);
+
+	for (int32 Species = 0; Species < Pond->FishSpecies.Num(); Species++)
+	{
+		for (int32 Fish = 0; Fish < FishPerSpecies; Fish++)
+		{
+			Pond->AddFish(
+				Species,
+				FVector(FMath::FRandRange(-SpawnRadius, SpawnRadius), FMath::FRandRange(-SpawnRadius, SpawnRadius), -1),
+				FVector(FMath::FRandRange(-SpawnRadius, SpawnRadius), FMath::FRandRange(-SpawnRadius, SpawnRadius), 0)
+			);
+		}
+	}
+
+	TArray<double> FrameTimes;
+	TArray<double> FrameAllocations;
+	FrameTimes.Reserve(Frames);
+	FrameAllocations.Reserve(Frames);
+
+	int32 Casts = 0;
+	int32 MissedCasts = 0;
+	int32 ActorsSpawned = 0;
+	int32 FishAcquired = 0;
+	int32 FishReleased = 0;
+	TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+	TSet<const AFish*> ActiveFish;
+	TSet<const AFish*> CurrentFish;
+	FDelegateHandle SpawnHandle;
+
+	uint64 TotalAllocations = 0;
+	uint64 TotalReallocations = 0;
+	uint64 TotalFrees = 0;
+
+	static FCountingMalloc CountingMalloc(GMalloc);
+	auto* EngineMalloc = GMalloc;
+
+	for (int32 Frame = 0; Frame < WarmupFrames + Frames; Frame++)
+	{
+		const bool bIsMeasured = Frame >= WarmupFrames;
+
+		// The spawns of the setup and the warmup are not churn
+		if (Frame == WarmupFrames)
+		{
+			for (TActorIterator<AFish> It(World); It; ++It)
+			{
+				if (!It->IsInPool())
+					ActiveFish.Add(*It);
+			}
+
+			SpawnHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateLambda(
+				[&ActorsSpawned, &SpawnedActors](AActor* Actor)
+				{
+					ActorsSpawned++;
+					SpawnedActors.Add(Actor);
+				}
+			));
+
+			GMalloc = &CountingMalloc;
+		}
+
+		UpdateCamera(Player, Frame);
+
+		if (Frame % CycleFrames == CastFrame)
+		{
+			for (TActorIterator<AFishingLure> It(World); It; ++It)
+			{
+				if (It->IsInPool())
+					continue;
+
+				if (It->IsCastable())
+				{
+					It->CastLure();
+					Casts++;
+				}
+				else
+				{
+					MissedCasts++;
+				}
+			}
+		}
+
+		// Only the frame itself is counted, not the bookkeeping of the benchmark
+		const uint64 AllocationsBefore = CountingMalloc.Allocations;
+		const uint64 ReallocationsBefore = CountingMalloc.Reallocations;
+		const uint64 FreesBefore = CountingMalloc.Frees;
+		const double StartTime = FPlatformTime::Seconds();
+
+		World->Tick(LEVELTICK_All, DeltaTime);
+
+		const double FrameTime = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		const uint64 Allocations = CountingMalloc.Allocations - AllocationsBefore;
+		TotalReallocations += CountingMalloc.Reallocations - ReallocationsBefore;
+		TotalFrees += CountingMalloc.Frees - FreesBefore;
+		GFrameCounter++;
+
+		if (!bIsMeasured)
+			continue;
+
+		TotalAllocations += Allocations;
+		FrameTimes.Add(FrameTime);
+		FrameAllocations.Add(static_cast<double>(Allocations));
+
+		// Fish taken from the pool or returned to it since the last frame
+		CurrentFish.Reset();
+
+		for (TActorIterator<AFish> It(World); It; ++It)
+		{
+			if (!It->IsInPool())
+				CurrentFish.Add(*It);
+		}
+
+		FishAcquired += CurrentFish.Difference(ActiveFish).Num();
+		FishReleased += ActiveFish.Difference(CurrentFish).Num();
+		Swap(ActiveFish, CurrentFish);
+	}
+
+	GMalloc = EngineMalloc;
+	World->RemoveOnActorSpawnedHandler(SpawnHandle);
+
+	int32 ActorsDestroyed = 0;
+
+	for (const auto& It : SpawnedActors)
+	{
+		if (!It.IsValid())
+			ActorsDestroyed++;
+	}
+
+	// Results
+	auto Memory = MakeShared<FJsonObject>();
+	Memory->SetNumberField(TEXT("allocations"), static_cast<double>(TotalAllocations));
+	Memory->SetNumberField(TEXT("reallocations"), static_cast<double>(TotalReallocations));
+	Memory->SetNumberField(TEXT("frees"), static_cast<double>(TotalFrees));
+	Memory->SetObjectField(TEXT("allocationsPerFrame"), MakeDistribution(FrameAllocations));
+
+	auto Churn = MakeShared<FJsonObject>();
+	Churn->SetNumberField(TEXT("actorsSpawned"), ActorsSpawned);
+	Churn->SetNumberField(TEXT("actorsDestroyed"), ActorsDestroyed);
+	Churn->SetNumberField(TEXT("fishAcquired"), FishAcquired);
+	Churn->SetNumberField(TEXT("fishReleased"), FishReleased);
+
+	auto Script = MakeShared<FJsonObject>();
+	Script->SetNumberField(TEXT("casts"), Casts);
+	Script->SetNumberField(TEXT("missedCasts"), MissedCasts);
+	Script->SetNumberField(TEXT("caughtFish"), Player->QuantityInTempInventory());
+
+	auto Results = MakeShared<FJsonObject>();
+	Results->SetStringField(TEXT("pond"), PondClass->GetPathName());
+	Results->SetNumberField(TEXT("species"), Pond->FishSpecies.Num());
+	Results->SetNumberField(TEXT("fishPerSpecies"), FishPerSpecies);
+	Results->SetNumberField(TEXT("frames"), Frames);
+	Results->SetNumberField(TEXT("deltaTime"), DeltaTime);
+	Results->SetNumberField(TEXT("seed"), Seed);
+	Results->SetObjectField(TEXT("frameMs"), MakeDistribution(FrameTimes));
+	Results->SetObjectField(TEXT("memory"), Memory);
+	Results->SetObjectField(TEXT("churn"), Churn);
+	Results->SetObjectField(TEXT("script"), Script);
+
+	FString Json;
+	const auto Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Results, Writer);
+
+	UE_LOG(LogPondBenchmark, Display, TEXT("%s"), *Json);
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+		UE_LOG(LogPondBenchmark, Warning, TEXT("Could not write %s"), *OutputPath);
+
+	// The pond waits for its ripple worker when it ends play
+	World->DestroyActor(Pond);
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	GWorld = PreviousWorld;
+	return 0;
+}
+
+void UPondBenchmarkCommandlet::UpdateCamera(ACustomARPawn* Player, const int32 Frame) const
+{
+	const float Time = Frame * DeltaTime;
+	const int32 CycleFrame = Frame % CycleFrames;
+
+	// Slow orbit around the pond, aiming at a circle the lure follows
+	const float OrbitAngle = FMath::DegreesToRadians(Time * OrbitSpeed);
+	auto Location = FVector(FMath::Cos(OrbitAngle), FMath::Sin(OrbitAngle), 0.f) * OrbitRadius + FVector(0, 0, OrbitHeight);
+	const auto AimPoint = FVector(FMath::Cos(OrbitAngle * 3.f), FMath::Sin(OrbitAngle * 3.f), 0.f) * AimRadius;
+
+	// Short impulses up and back down, the camera is back on the orbit once they are over
+	const auto Impulse = [this, CycleFrame](const int32 StartFrame, const float Speed)
+	{
+		const float ImpulseTimeElapsed = (CycleFrame - StartFrame) * DeltaTime;
+
+		if (ImpulseTimeElapsed < 0.f || ImpulseTimeElapsed > ImpulseTime)
+			return 0.f;
+
+		return Speed * (ImpulseTime * 0.5f - FMath::Abs(ImpulseTimeElapsed - ImpulseTime * 0.5f));
+	};
+
+	Location.Z += Impulse(TugFrame, TugSpeed) + Impulse(JerkFrame, JerkSpeed);
+
+	Player->CameraComponent->SetWorldLocationAndRotation(Location, (AimPoint - Location).Rotation());
+}
+
+TSharedRef<FJsonObject> UPondBenchmarkCommandlet::MakeDistribution(TArray<double>& Values)
+{
+	Values.Sort();
+
+	double Sum = 0.0;
+
+	for (const double It : Values)
+		Sum += It;
+
+	auto Distribution = MakeShared<FJsonObject>();
+	Distribution->SetNumberField(TEXT("mean"), Values.Num() > 0 ? Sum / Values.Num() : 0.0);
+	Distribution->SetNumberField(TEXT("p50"), Percentile(Values, 50.0));
+	Distribution->SetNumberField(TEXT("p90"), Percentile(Values, 90.0));
+	Distribution->SetNumberField(TEXT("p95"), Percentile(Values, 95.0));
+	Distribution->SetNumberField(TEXT("p99"), Percentile(Values, 99.0));
+	Distribution->SetNumberField(TEXT("max"), Values.Num() > 0 ? Values.Last() : 0.0);
+	return Distribution;
+}
+
+double UPondBenchmarkCommandlet::Percentile(const TArray<double>& Sorted, const double Percent)
+{
+	if (Sorted.Num() == 0)
+		return 0.0;
+
+	// Nearest rank
+	const int32 Rank = FMath::CeilToInt(Percent / 100.0 * Sorted.Num());
+	return Sorted[FMath::Clamp(Rank - 1, 0, Sorted.Num() - 1)];
+}
@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PondRippleSimulation.h"
+
+FPondRippleSimulation::~FPondRippleSimulation()
+{
+	Wait();
+}
+
+void FPondRippleSimulation::Initialize(const int32 InResolution, const float InRate, const float InDamping)
+{
+	Wait();
+
+	Resolution = FMath::Max(Align(InResolution, 4), 4);
+	Stride = Resolution + 2;
+	Damping = FMath::Clamp(InDamping, 0.f, 0.999f);
+
+	// The border around the surface is never written, reading the neighbours of the edge cells needs no checks
+	CurrentHeights.Init(0.f, Stride * Stride);
+	PreviousHeights.Init(0.f, Stride * Stride);
+	WorkerPixels.Init(128, Resolution * Resolution);
+	Pixels.Init(128, Resolution * Resolution);
+
+	PendingImpulses.Reset();
+	Clock.SetRate(InRate, MaxStepsPerRun);
+	PendingSteps = 0;
+	bIsAtRest = true;
+}
+
+void FPondRippleSimulation::AddImpulse(const float U, const float V, const float Strength, const float Radius)
+{
+	if (Resolution == 0 || U < 0.f || U > 1.f || V < 0.f || V > 1.f)
+		return;
+
+	FRippleImpulse Impulse;
+	Impulse.X = U * Resolution;
+	Impulse.Y = V * Resolution;
+	Impulse.Strength = Strength;
+	Impulse.Radius = FMath::Max(Radius * Resolution, 1.f);
+	PendingImpulses.Add(Impulse);
+}
+
+bool FPondRippleSimulation::Update(const float DeltaTime)
+{
+	if (Resolution == 0)
+		return false;
+
+	PendingSteps = FMath::Min(PendingSteps + Clock.Advance(DeltaTime), MaxStepsPerRun);
+
+	if (Task.IsValid() && !Task.IsCompleted())
+		return false;
+
+	bool bHasNewPixels = false;
+
+	if (Task.IsValid())
+	{
+		Task = UE::Tasks::FTask();
+		Swap(Pixels, WorkerPixels);
+		bHasNewPixels = true;
+	}
+
+	// A still surface costs nothing until it is disturbed again
+	if (bIsAtRest && PendingImpulses.Num() == 0)
+		PendingSteps = 0;
+
+	if (PendingSteps == 0)
+		return bHasNewPixels;
+
+	const int32 Steps = PendingSteps;
+	PendingSteps = 0;
+
+	Task = UE::Tasks::Launch(
+		TEXT("PondRippleSimulation"),
+		[this, Steps, Impulses = MoveTemp(PendingImpulses)]()
+		{
+			Run(Steps, Impulses);
+		}
+	);
+
+	PendingImpulses.Reset();
+	return bHasNewPixels;
+}
+
+void FPondRippleSimulation::Wait()
+{
+	if (Task.IsValid())
+		Task.Wait();
+
+	Task = UE::Tasks::FTask();
+}
+
+void FPondRippleSimulation::Run(const int32 Steps, const TArray<FRippleImpulse>& Impulses)
+{
+	for (const auto& It : Impulses)
+	{
+		const int32 MinX = FMath::Max(FMath::FloorToInt(It.X - It.Radius), 0);
+		const int32 MaxX = FMath::Min(FMath::CeilToInt(It.X + It.Radius), Resolution - 1);
+		const int32 MinY = FMath::Max(FMath::FloorToInt(It.Y - It.Radius), 0);
+		const int32 MaxY = FMath::Min(FMath::CeilToInt(It.Y + It.Radius), Resolution - 1);
+
+		// Smooth bump, a single cell spike would only make noise
+		for (int32 Y = MinY; Y <= MaxY; Y++)
+		{
+			for (int32 X = MinX; X <= MaxX; X++)
+			{
+				const float DistanceSquared = FMath::Square(X + 0.5f - It.X) + FMath::Square(Y + 0.5f - It.Y);
+				const float Falloff = 1.f - DistanceSquared / FMath::Square(It.Radius);
+
+				if (Falloff > 0.f)
+					CurrentHeights[(Y + 1) * Stride + X + 1] += It.Strength * Falloff * Falloff;
+			}
+		}
+	}
+
+	float MaxHeight = 0.f;
+
+	for (int32 It = 0; It < Steps; It++)
+		MaxHeight = Step();
+
+	bIsAtRest = MaxHeight < RestHeight;
+
+	// Heights from -1 to 1 mapped onto the full byte range
+	for (int32 Y = 0; Y < Resolution; Y++)
+	{
+		const float* Row = &CurrentHeights[(Y + 1) * Stride + 1];
+		uint8* PixelRow = &WorkerPixels[Y * Resolution];
+
+		for (int32 X = 0; X < Resolution; X++)
+			PixelRow[X] = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Row[X] * 127.f) + 128, 0, 255));
+	}
+}
+
+float FPondRippleSimulation::Step()
+{
+	const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+	const VectorRegister4Float DampingFactor = VectorSetFloat1(Damping);
+	VectorRegister4Float MaxHeight = VectorZeroFloat();
+
+	const float* Current = CurrentHeights.GetData();
+	float* Next = PreviousHeights.GetData();
+
+	// Row by row, the three rows read at once stay in the cache
+	for (int32 Y = 1; Y <= Resolution; Y++)
+	{
+		for (int32 Index = Y * Stride + 1; Index <= Y * Stride + Resolution; Index += 4)
+		{
+			const VectorRegister4Float Neighbours = VectorAdd(
+				VectorAdd(VectorLoad(&Current[Index - 1]), VectorLoad(&Current[Index + 1])),
+				VectorAdd(VectorLoad(&Current[Index - Stride]), VectorLoad(&Current[Index + Stride]))
+			);
+
+			// The next heights overwrite the previous ones, each cell only reads its own previous height
+			const VectorRegister4Float Height = VectorMultiply(
+				VectorSubtract(VectorMultiply(Neighbours, Half), VectorLoad(&Next[Index])),
+				DampingFactor
+			);
+
+			VectorStore(Height, &Next[Index]);
+			MaxHeight = VectorMax(MaxHeight, VectorAbs(Height));
+		}
+	}
+
+	Swap(CurrentHeights, PreviousHeights);
+
+	float Lanes[4];
+	VectorStore(MaxHeight, Lanes);
+	return FMath::Max(FMath::Max(Lanes[0], Lanes[1]), FMath::Max(Lanes[2], Lanes[3]));
+}
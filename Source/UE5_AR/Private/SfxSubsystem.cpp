@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SfxSubsystem.h"
+
+#include "Components/AudioComponent.h"
+#include "GameFramework/WorldSettings.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sound/SoundBase.h"
+
+void USfxSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// The voices live for the whole world, no audio component is created while playing
+	for (int32 Index = 0; Index < MaxVoices; Index++)
+	{
+		auto* Voice = NewObject<UAudioComponent>(InWorld.GetWorldSettings());
+		Voice->bAutoActivate = false;
+		Voice->bAutoDestroy = false;
+		Voice->RegisterComponentWithWorld(&InWorld);
+		Voices.Add(Voice);
+		VoiceStartTimes.Add(0.f);
+	}
+}
+
+void USfxSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Requests.Num() == 0)
+		return;
+
+	const auto* CameraManager = UGameplayStatics::GetPlayerCameraManager(this, 0);
+	const bool bHasListener = IsValid(CameraManager);
+	const auto ListenerLocation = bHasListener ? CameraManager->GetCameraLocation() : FVector::ZeroVector;
+	const float Time = GetWorld()->GetTimeSeconds();
+
+	for (const auto& It : Requests)
+	{
+		auto* Sound = It.Sound.Get();
+
+		if (!IsValid(Sound))
+			continue;
+
+		if (bHasListener && FVector::DistSquared(ListenerLocation, It.Location) > FMath::Square(MaxAudibleDistance))
+			continue;
+
+		const int32 VoiceIndex = FindVoice(Sound);
+
+		if (VoiceIndex == INDEX_NONE)
+			continue;
+
+		auto* Voice = Voices[VoiceIndex];
+		Voice->Stop();
+		Voice->SetSound(Sound);
+		Voice->SetVolumeMultiplier(It.VolumeMultiplier);
+		Voice->SetWorldLocation(It.Location);
+		Voice->Play();
+		VoiceStartTimes[VoiceIndex] = Time;
+	}
+
+	Requests.Reset();
+}
+
+TStatId USfxSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USfxSubsystem, STATGROUP_Tickables);
+}
+
+void USfxSubsystem::PlaySound(USoundBase* Sound, const FVector& Location, const float VolumeMultiplier)
+{
+	if (!IsValid(Sound))
+		return;
+
+	// Played before the voices exist, e.g. during BeginPlay of the level actors
+	if (Voices.Num() == 0)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, Sound, Location, VolumeMultiplier);
+		return;
+	}
+
+	// A burst of the same sound at one place, e.g. several fish spooked at once, is heard once
+	for (auto& It : Requests)
+	{
+		if (It.Sound == Sound && FVector::DistSquared(It.Location, Location) < FMath::Square(CoalesceRadius))
+		{
+			It.VolumeMultiplier = FMath::Max(It.VolumeMultiplier, VolumeMultiplier);
+			return;
+		}
+	}
+
+	FSfxRequest Request;
+	Request.Sound = Sound;
+	Request.Location = Location;
+	Request.VolumeMultiplier = VolumeMultiplier;
+	Requests.Add(Request);
+}
+
+void USfxSubsystem::PlaySoundAtLocation(const UObject* WorldContext, USoundBase* Sound, const FVector& Location, const float VolumeMultiplier)
+{
+	if (!IsValid(Sound) || !IsValid(WorldContext))
+		return;
+
+	const auto* World = WorldContext->GetWorld();
+	auto* Sfx = IsValid(World) ? World->GetSubsystem<USfxSubsystem>() : nullptr;
+
+	if (IsValid(Sfx))
+		Sfx->PlaySound(Sound, Location, VolumeMultiplier);
+	else
+		UGameplayStatics::PlaySoundAtLocation(WorldContext, Sound, Location, VolumeMultiplier);
+}
+
+int32 USfxSubsystem::FindVoice(const USoundBase* Sound) const
+{
+	int32 FreeVoice = INDEX_NONE;
+	int32 OldestVoice = INDEX_NONE;
+	int32 OldestVoiceOfSound = INDEX_NONE;
+	int32 VoicesOfSound = 0;
+
+	for (int32 Index = 0; Index < Voices.Num(); Index++)
+	{
+		const auto* Voice = Voices[Index];
+
+		if (!IsValid(Voice))
+			continue;
+
+		if (!Voice->IsPlaying())
+		{
+			if (FreeVoice == INDEX_NONE)
+				FreeVoice = Index;
+
+			continue;
+		}
+
+		if (OldestVoice == INDEX_NONE || VoiceStartTimes[Index] < VoiceStartTimes[OldestVoice])
+			OldestVoice = Index;
+
+		if (Voice->Sound != Sound)
+			continue;
+
+		VoicesOfSound++;
+
+		if (OldestVoiceOfSound == INDEX_NONE || VoiceStartTimes[Index] < VoiceStartTimes[OldestVoiceOfSound])
+			OldestVoiceOfSound = Index;
+	}
+
+	// The sound replaces its own oldest voice rather than taking more
+	if (VoicesOfSound >= MaxVoicesPerSound)
+		return OldestVoiceOfSound;
+
+	return FreeVoice != INDEX_NONE ? FreeVoice : OldestVoice;
+}
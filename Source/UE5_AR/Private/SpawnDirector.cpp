@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SpawnDirector.h"
+
+#include "RenderCore.h"
+
+void FSpawnDirector::Reset(const int32 InMinPopulation, const int32 InMaxPopulation, const float InSpawnInterval, const float InFrameBudget)
+{
+	MaxPopulation = FMath::Max(InMaxPopulation, 0);
+	MinPopulation = FMath::Clamp(InMinPopulation, 0, MaxPopulation);
+	SpawnInterval = FMath::Max(InSpawnInterval, KINDA_SMALL_NUMBER);
+	FrameBudget = FMath::Max(InFrameBudget, 1.f);
+
+	// The middle is reached quickly from both ends, neither device class waits long for its population
+	TargetPopulation = (MinPopulation + MaxPopulation) * 0.5f;
+	SmoothedFrameTime = FrameBudget * HeadroomLoad;
+	AdjustTimer = 0.f;
+	SpawnTimer = 0.f;
+}
+
+int32 FSpawnDirector::Update(const float DeltaTime, const float FrameTime, const int32 Population)
+{
+	SmoothedFrameTime = FMath::Lerp(SmoothedFrameTime, FrameTime, FrameTimeSmoothing);
+	AdjustTimer += DeltaTime;
+	SpawnTimer += DeltaTime;
+
+	if (AdjustTimer >= AdjustInterval)
+	{
+		AdjustTimer = 0.f;
+		const float Load = SmoothedFrameTime / FrameBudget;
+
+		// Quick to back off, slow to grow, the population settles just under the budget
+		if (Load > 1.f)
+			TargetPopulation = FMath::Max(TargetPopulation * DecreaseFactor, static_cast<float>(MinPopulation));
+		else if (Load < HeadroomLoad)
+			TargetPopulation = FMath::Min(TargetPopulation + FMath::Max(TargetPopulation * IncreaseFraction, 1.f), static_cast<float>(MaxPopulation));
+	}
+
+	const int32 Target = GetTargetPopulation();
+
+	if (Population == Target)
+	{
+		SpawnTimer = FMath::Min(SpawnTimer, SpawnInterval);
+		return 0;
+	}
+
+	// An empty pond fills up quickly, the last few fish trickle in at the base interval
+	const float Fill = Target > 0 ? static_cast<float>(Population) / Target : 1.f;
+	const float Interval = SpawnInterval * FMath::Clamp(Fill, MinSpawnIntervalScale, 1.f);
+
+	if (SpawnTimer < Interval)
+		return 0;
+
+	SpawnTimer = 0.f;
+	return Population < Target ? 1 : -1;
+}
+
+float FSpawnDirector::MeasureFrameTime()
+{
+	return FPlatformTime::ToMilliseconds(FMath::Max(GGameThreadTime, GRenderThreadTime));
+}
@@ -19,11 +19,12 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "ARTrackable.h"
+#include "ActorPoolSubsystem.h"
 
 #include "ARPlaneActor.generated.h"
 
 UCLASS()
-class UE5_AR_API AARPlaneActor : public AActor
+class UE5_AR_API AARPlaneActor : public AActor, public IPoolableActor
 {
 	GENERATED_BODY()
 
@@ -66,4 +67,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GoogleARCorePlaneActor")
 		void SetColor(FColor InColor);
 
+	// Pooling: new texture rotation when reused, geometry and mesh dropped when released
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
+
 };
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/Interface.h"
+#include "ActorPoolSubsystem.generated.h"
+
+UINTERFACE(MinimalAPI)
+class UPoolableActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+//! @brief Interface of the actors recycled by the actor pool
+//! Pooled actors are spawned once, BeginPlay is not called again when they are reused
+class UE5_AR_API IPoolableActor
+{
+	GENERATED_BODY()
+
+public:
+
+	//! @brief Event function called when the actor is taken out of the pool, after it was placed and activated
+	//! Should do what BeginPlay would do for a freshly spawned actor
+	virtual void OnAcquiredFromPool() {}
+
+	//! @brief Event function called when the actor is returned to the pool, before it is deactivated
+	//! Should return the actor state to the class defaults
+	virtual void OnReleasedToPool() {}
+};
+
+//! @brief Structure wrapping the free actors of one class, needed for the garbage collector to see them
+USTRUCT()
+struct FActorPoolList
+{
+	GENERATED_BODY()
+
+	//! Deactivated actors waiting to be reused
+	UPROPERTY()
+		TArray<AActor*> Actors;
+};
+
+//! @brief World subsystem pre-warming and recycling actors instead of spawning and destroying them
+//! Released actors are hidden, without collision and tick, until they are acquired again
+UCLASS()
+class UE5_AR_API UActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// Functions
+
+	//! @brief Function taking an actor of the class out of the pool, spawning a new one if the pool is empty
+	//! @param Class - Class of the actor, has to be exact, subclasses are pooled separately.
+	//! @param Transform - World transform to place the actor at.
+	//! @returns [value] - Pointer to the active actor.
+	//! @returns nullptr - If the actor could not be spawned.
+	AActor* Acquire(UClass* Class, const FTransform& Transform = FTransform::Identity);
+
+	//! @brief Function returning the actor into the pool, destroys it if the pool of its class is full
+	//! @param Actor - Active actor to release, can come from outside of the pool.
+	void Release(AActor* Actor);
+
+	//! @brief Function spawning deactivated actors of the class until the pool holds the given count
+	//! @param Class - Class of the actors.
+	//! @param Count - Number of free actors the pool should hold.
+	void Prewarm(UClass* Class, const int32 Count);
+
+	//! @brief Function checking whether the actor is deactivated in the pool
+	//! @param Actor - The actor to check.
+	//! @returns true - If the actor waits in the pool.
+	//! @returns false - otherwise.
+	bool IsInPool(const AActor* Actor) const { return PooledActors.Contains(Actor); }
+
+	//! @brief Convenience function acquiring from the pool of the world, spawning directly if the pool is not available
+	//! @param WorldContext - Any object of the world.
+	//! @param Class - Class of the actor.
+	//! @param Transform - World transform to place the actor at.
+	//! @returns [value] - Pointer to the active actor, can be nullptr.
+	static AActor* AcquireActor(const UObject* WorldContext, UClass* Class, const FTransform& Transform = FTransform::Identity);
+
+	//! @brief Typed version of AcquireActor
+	template<typename ActorType>
+	static ActorType* AcquireActor(const UObject* WorldContext, TSubclassOf<ActorType> Class, const FTransform& Transform = FTransform::Identity)
+	{
+		return Cast<ActorType>(AcquireActor(WorldContext, Class.Get(), Transform));
+	}
+
+	//! @brief Convenience function releasing into the pool of the actor world, destroying the actor if the pool is not available
+	//! @param Actor - Active actor to release.
+	static void ReleaseActor(AActor* Actor);
+
+	// Constants
+
+	//! Maximum number of free actors kept per class
+	static constexpr int32 MaxFreeActorsPerClass = 32;
+
+protected:
+
+	//Hidden
+
+	//! @brief Function switching the actor between active and pooled
+	//! @param Actor - Valid actor.
+	//! @param bIsActive - Whether the actor should be visible, collide and tick.
+	static void SetActorActive(AActor* Actor, const bool bIsActive);
+
+	//Hidden properties
+
+	//! Free actors of each class
+	UPROPERTY()
+		TMap<UClass*, FActorPoolList> FreeActors;
+
+	//! All actors currently waiting in the pool
+	UPROPERTY()
+		TSet<AActor*> PooledActors;
+};
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//! @brief Table sampling an index with a probability proportional to its weight in constant time
+//! Every index owns one column split between itself and one alias index (Vose's alias method),
+//! a sample picks a column and one side of its split from a single random number
+class UE5_AR_API FAliasTable
+{
+public:
+
+	// Functions
+
+	//! @brief Function building the table from the weights, in linear time
+	//! @param Weights - Weight of each index, negative weights count as 0.
+	void Build(const TArray<float>& Weights);
+
+	//! @brief Function picking a random index
+	//! @param Random - Uniformly distributed random number from 0 to 1.
+	//! @returns [value] - Index picked with the probability of its weight.
+	//! @returns INDEX_NONE - If the table is empty or all the weights are 0.
+	int32 Sample(const float Random) const;
+
+	//! @brief Function returning the number of indices in the table
+	//! @returns [value] - The number of weights the table was built from, 0 if all of them were 0.
+	int32 Num() const { return Probability.Num(); }
+
+protected:
+
+	//Hidden
+
+	//! Chance of each column to pick its own index instead of the alias
+	TArray<float> Probability;
+
+	//! Index picked by each column on the other side of its split
+	TArray<int32> Alias;
+};
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//! @brief Predictor of the camera pose, extrapolating the tracked poses to the time the frame is displayed
+//! Runs an alpha-beta filter on the location and the rotation of the timestamped camera poses.
+//! The filter smooths the tracking jitter and estimates the velocities, the prediction extrapolates them with constant velocity.
+class UE5_AR_API FCameraPosePredictor
+{
+public:
+
+	// Functions
+
+	//! @brief Update function adding the tracked camera pose of the frame
+	//! @param Time - Timestamp of the pose in seconds, has to grow.
+	//! @param CameraTransform - World transform of the camera.
+	void AddPose(const double Time, const FTransform& CameraTransform);
+
+	//! @brief Function forgetting the filter state, the next pose starts a new history
+	void Reset() { bIsValid = false; }
+
+	//! @brief Function extrapolating the filtered pose
+	//! @param Time - Timestamp to predict the pose at, the extrapolation is capped at MaxPredictionTime past the last pose.
+	//! @returns [value] - The predicted camera transform, identity before the first pose.
+	FTransform Predict(const double Time) const;
+
+	//! @brief Function returning the average time between the poses
+	//! @returns [value] - Smoothed frame interval in seconds.
+	float GetFrameInterval() const { return FrameInterval; }
+
+	//! @brief Function returning the timestamp of the last pose
+	//! @returns [value] - Time of the last pose in seconds.
+	double GetLastTime() const { return LastTime; }
+
+	//! @brief Function returning the filtered camera velocity
+	//! @returns [value] - World space velocity in units per second.
+	const FVector& GetVelocity() const { return Velocity; }
+
+	// Constants
+
+	//! Gain of the location and rotation correction, lower is smoother but lags more
+	static constexpr float Alpha = 0.5f;
+
+	//! Gain of the velocity correction, lower is smoother but reacts slower to changes of the motion
+	static constexpr float Beta = 0.1f;
+
+	//! Longest extrapolation in seconds, longer ones overshoot more than they help
+	static constexpr double MaxPredictionTime = 0.1;
+
+	//! Gap in seconds between poses after which the history is dropped, such as after a pause
+	static constexpr double ResetTime = 0.5;
+
+protected:
+
+	//Hidden
+
+	//! @brief Function turning a rotation vector into a rotation
+	//! @param RotationVector - Rotation axis scaled by the angle in radians.
+	//! @returns [value] - The rotation.
+	static FQuat FromRotationVector(const FVector& RotationVector);
+
+	//! @brief Function turning a rotation into the shortest rotation vector
+	//! @param Rotation - The rotation.
+	//! @returns [value] - Rotation axis scaled by the angle in radians.
+	static FVector ToRotationVector(const FQuat& Rotation);
+
+	//! Filtered location and rotation at the time of the last pose
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+
+	//! Filtered velocities, the angular one as a rotation vector per second
+	FVector Velocity = FVector::ZeroVector;
+	FVector AngularVelocity = FVector::ZeroVector;
+
+	//! Timestamp of the last pose
+	double LastTime = 0.0;
+
+	//! Smoothed time between the poses
+	float FrameInterval = 1.f / 30.f;
+
+	//! Flag noting the filter holds a real camera pose
+	bool bIsValid = false;
+};
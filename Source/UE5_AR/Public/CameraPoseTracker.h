@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//! @brief Tracker of the camera pose, updated once per frame by the player and read by everything camera relative
+//! Publishes the change since the last frame and whether the camera moved noticeably since the last noticeable move.
+//! The second one is measured from the pose of the last noticeable move, so slow drifts add up instead of being ignored.
+class UE5_AR_API FCameraPoseTracker
+{
+public:
+
+	// Functions
+
+	//! @brief Update function taking the camera pose of the frame
+	//! @param CameraTransform - World transform of the camera.
+	void Update(const FTransform& CameraTransform);
+
+	//! @brief Function forgetting the poses, the next update counts as a move
+	void Reset() { bIsValid = false; }
+
+	//! @brief Function returning the world transform of the camera this frame
+	//! @returns [value] - The camera transform.
+	const FTransform& GetPose() const { return Pose; }
+
+	//! @brief Function returning the camera movement since the last frame
+	//! @returns [value] - World space location difference.
+	const FVector& GetFrameLocationDelta() const { return FrameLocationDelta; }
+
+	//! @brief Function returning the camera rotation since the last frame
+	//! @returns [value] - Difference of the rotator components.
+	const FRotator& GetFrameRotationDelta() const { return FrameRotationDelta; }
+
+	//! @brief Function checking whether the camera moved noticeably since the last frame
+	//! @returns true - If the camera moved or turned by more than the tolerances.
+	//! @returns false - otherwise.
+	bool HasMovedThisFrame() const { return bHasMovedThisFrame; }
+
+	//! @brief Function checking whether camera relative results have to be refreshed this frame
+	//! @returns true - If the camera moved or turned by more than the tolerances since the last time this was true.
+	//! @returns false - If the results of the last refresh are still good.
+	bool HasMoved() const { return bHasMoved; }
+
+	// Constants
+
+	//! Smallest noticeable movement, in world units
+	static constexpr float LocationTolerance = 0.1f;
+
+	//! Smallest noticeable rotation, in degrees
+	static constexpr float RotationTolerance = 0.1f;
+
+protected:
+
+	//Hidden
+
+	//! @brief Function checking whether two poses are noticeably different
+	//! @param A - First camera transform.
+	//! @param B - Second camera transform.
+	//! @returns true - If the location or rotation differ by more than the tolerances.
+	//! @returns false - otherwise.
+	static bool IsNoticeablyDifferent(const FTransform& A, const FTransform& B);
+
+	//! Camera transform of the current frame
+	FTransform Pose;
+
+	//! Camera transform of the last noticeable move
+	FTransform ReferencePose;
+
+	//! Camera movement and rotation since the last frame
+	FVector FrameLocationDelta = FVector::ZeroVector;
+	FRotator FrameRotationDelta = FRotator::ZeroRotator;
+
+	//! Flags noting a noticeable move since the last frame and since the last noticeable move
+	bool bHasMovedThisFrame = true;
+	bool bHasMoved = true;
+
+	//! Flag noting the poses hold a real camera pose
+	bool bIsValid = false;
+};
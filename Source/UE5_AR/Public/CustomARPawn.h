@@ -3,8 +3,12 @@
 #pragma once
 
 #include "GameFramework/Pawn.h"
-#include "Misc/DateTime.h"
 #include "CustomGameMode.h"
+#include "CameraPoseTracker.h"
+#include "CameraPosePredictor.h"
+#include "MotionDetector.h"
+#include "GestureRecognizer.h"
+#include "LateUpdateTickFunction.h"
 #include "CustomARPawn.generated.h"
 
 class UCameraComponent;
@@ -42,6 +46,10 @@ protected:
 	//! @brief Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	//! @brief Called to (un)register the tick functions, registers the late update tick along the primary one
+	//! @param bRegister - Whether to register or unregister.
+	virtual void RegisterActorTickFunctions(bool bRegister) override;
+
 public:
 
 	//! @brief Called every frame
@@ -206,19 +214,46 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Custom AR Pawn Audio")
 		void SilenceBGMForSFX(float SilenceTime = 1.5);
 
+	//! @brief Function returning the tracker of the camera pose, updated at the start of the player tick
+	//! Camera relative actors tick after the player and can skip their work while the camera stays still
+	//! @returns [value] - Reference to the camera pose tracker.
+	const FCameraPoseTracker& GetCameraPose() const { return CameraPose; }
+
+	//! @brief Function returning the tracker of the camera pose the frame is rendered with, updated in the late update tick
+	//! Only valid in the late update ticks following the one of the player, see GetLateUpdateTick
+	//! @returns [value] - Reference to the late camera pose tracker.
+	const FCameraPoseTracker& GetLateCameraPose() const { return LateCameraPose; }
+
+	//! @brief Function returning the tick function updating the late camera pose, late camera relative work has to come after it
+	//! @returns [value] - Reference to the late update tick function.
+	FTickFunction& GetLateUpdateTick() { return LateUpdateTick; }
+
+	//! @brief Function returning the camera pose predicted for the time the last rendered frame is displayed
+	//! Extrapolated CameraPredictionFrames frame intervals past the last rendered pose, smooth enough to aim with
+	//! @returns [value] - The predicted camera transform.
+	FTransform GetPredictedCameraPose() const;
+
 	// Constants
 
-	//! The number of frames to wait when determining the touch type
+	//! The distance in pixels a finger has to move for the touch to become a drag
+	UPROPERTY(Category = "Custom AR Pawn Constants", EditAnywhere, BlueprintReadWrite)
+		float TouchDragDistance = 10.f;
+
+	//! The longest duration in seconds of a touch still considered a tap
+	UPROPERTY(Category = "Custom AR Pawn Constants", EditAnywhere, BlueprintReadWrite)
+		float TouchTapTime = 0.3f;
+
+	//! The number of frames between the simulation and the display, the camera pose is predicted that far ahead
 	UPROPERTY(Category = "Custom AR Pawn Constants", EditAnywhere, BlueprintReadWrite)
-		int HoldFrames = 10;
+		float CameraPredictionFrames = 1.f;
 
-	//! The minimum movement delta for a movement to be considered sudden and fire relevant events
+	//! The minimum camera speed in units per second for a movement to be considered sudden and fire relevant events
 	UPROPERTY(Category = "Custom AR Pawn Constants", EditAnywhere, BlueprintReadWrite)
 		float MovementMotionSensitivity = 25.f;
 
-	//! The minimum rotation delta for a rotation to be considered sudden and fire relevant events
+	//! The minimum camera angular speed in degrees per second for a rotation to be considered sudden and fire relevant events
 	UPROPERTY(Category = "Custom AR Pawn Constants", EditAnywhere, BlueprintReadWrite)
-		float RotationMotionSensitivity = 20.f;
+		float RotationMotionSensitivity = 180.f;
 
 	// Assets
 
@@ -243,12 +278,22 @@ protected:
 
 	// Events
 
-	//! @brief Function to be bound for the release touch input. Handles resetting to correct touch type.
+	//! @brief Function to be bound for the pressed touch input of any finger. Passes the touch to the gesture recognizer.
+	//! @param FingerIndex - The touch index in case multiple touches happen.
+	//! @param ScreenPos - Screen space position of the touch.
+	void OnTouchInputPressed(const ETouchIndex::Type FingerIndex, const FVector ScreenPos);
+
+	//! @brief Function to be bound for the moved touch input of any finger. Passes the touch to the gesture recognizer.
 	//! @param FingerIndex - The touch index in case multiple touches happen.
 	//! @param ScreenPos - Screen space position of the touch.
-	void OnScreenTouchReleaseMandatory(const ETouchIndex::Type FingerIndex, const FVector ScreenPos);
+	void OnTouchInputMoved(const ETouchIndex::Type FingerIndex, const FVector ScreenPos);
 
-	//! @brief Function called when a touch is considered to be non-dragging.
+	//! @brief Function to be bound for the released touch input of any finger. Passes the touch to the gesture recognizer.
+	//! @param FingerIndex - The touch index in case multiple touches happen.
+	//! @param ScreenPos - Screen space position of the touch.
+	void OnTouchInputReleased(const ETouchIndex::Type FingerIndex, const FVector ScreenPos);
+
+	//! @brief Function called when a touch is considered to be a tap.
 	//! @param FingerIndex - The touch index in case multiple touches happen.
 	//! @param ScreenPos - Screen space position of the touch.
 	virtual void OnScreenTouchRelease(const ETouchIndex::Type FingerIndex, const FVector &ScreenPos);
@@ -258,50 +303,71 @@ protected:
 	//! @param ScreenPos - Screen space position of the touch.
 	virtual void OnScreenDrag(const ETouchIndex::Type FingerIndex, const FVector &ScreenPos);
 
+	//! @brief Function called when two fingers move, scales and rotates the selected actor.
+	//! @param Scale - Ratio of the distances between the fingers since the last move.
+	//! @param Rotation - Change of the angle between the fingers since the last move, in degrees.
+	virtual void OnScreenPinch(const float Scale, const float Rotation);
+
 	//! @brief Function called as a response to sudden movement.
-	//! @param MovementDelta - The movement difference from last frame in world-space.
-	virtual void OnSuddenMovement(const FVector &MovementDelta);
+	//! @param MovementVelocity - The sudden part of the camera velocity in world-space, units per second.
+	virtual void OnSuddenMovement(const FVector &MovementVelocity);
 
 	//! @brief Function called as a response to sudden rotation.
-	//! @param RotationDelta - The rotation difference from last frame in world-space.
+	//! @param RotationDelta - The camera rotation over the detection window in world-space.
 	virtual void OnSuddenRotation(const FRotator &RotationDelta);
 
 	// Input Processing
 
 	//! @brief Function that propagates the touch input to the correct objects
-	//! Performs a line trace
-	//! Calls relevant event function of objects or game mode
+	//! Starts an asynchronous line trace, the touch is resolved once its result arrives the next frame
 	//! @param FingerIndex - The touch index in case multiple touches happen.
 	//! @param ScreenPos - Screen space position of the touch.
-	virtual void HandleTouchInput(const ETouchIndex::Type FingerIndex, const FVector& ScreenPos);
+	//! @param Gesture - Type of the touch, tap or drag.
+	virtual void HandleTouchInput(const ETouchIndex::Type FingerIndex, const FVector& ScreenPos, const ETouchGesture::Type Gesture);
 
-	//! @brief Function used to process the touch input to determine its type.
-	void ProcessTouchInput();
+	//! @brief Function called with the result of the line trace of a touch
+	//! Calls relevant event function of objects or game mode
+	//! @param ARHits - The AR plane hits of the traced line, only traced if no actor was hit.
+	//! @param HitResult - First actor hit by the traced line.
+	//! @param HitDirection - Direction of the traced line.
+	//! @param FingerIndex - The touch index in case multiple touches happen.
+	//! @param Gesture - Type of the touch, tap or drag.
+	void OnTouchTraceDone(const TArray<FARTraceResult>& ARHits, const FHitResult& HitResult, const FVector& HitDirection, const ETouchIndex::Type FingerIndex, const ETouchGesture::Type Gesture);
+
+	//! @brief Function calling the event function of a gesture recognized from the touch input
+	//! @param FingerIndex - The touch index of the event the gesture was recognized at.
+	//! @param Gesture - The recognized gesture.
+	void ProcessGesture(const ETouchIndex::Type FingerIndex, const FTouchGesture& Gesture);
 
-	//! @brief Function used to track the movement differences and determine whether they were sudden
-	//! Calls relevant event responses if the movements were sudden
-	//! @param DeltaTime - Time between frames
-	void ProcessMotionInput(const float DeltaTime);
+	//! @brief Function passing the camera pose to the motion detector and responding to the sudden motions it detects
+	//! Called from the late update tick, calls relevant event responses if the movements were sudden
+	//! @param RenderedPose - World transform of the camera the frame is rendered with.
+	void ProcessMotionInput(const FTransform& RenderedPose);
 
 	// Data
 
-	//! @brief Enumerator specifying the type of touch 
-	enum class TouchType
-	{
-		None,
-		Deliberating,
-		Press,
-		Drag
-	}InputTouch = TouchType::None;
+	//! Recognizer of the gestures of all fingers, driven by the touch input events
+	FGestureRecognizer GestureRecognizer;
+
+	//! The latest drag of the frame, all drags of a frame are coalesced into one line trace started at the tick
+	FVector PendingDragPos = FVector::ZeroVector;
+	ETouchIndex::Type PendingDragFinger = ETouchIndex::Touch1;
+	bool bHasPendingDrag = false;
+
+	//! Pose of the camera this frame and its change since the last frame
+	FCameraPoseTracker CameraPose;
+
+	//! Pose of the camera after the camera manager update, the one the frame is rendered with
+	FCameraPoseTracker LateCameraPose;
 
-	//! Timestamp, in system tick count, of the last touch input 
-	FDateTime TouchTimestamp = FDateTime::Now();
+	//! Tick function updating the late camera pose after the camera manager update
+	FLateUpdateTickFunction LateUpdateTick;
 
-	//! Cached player rotation form the last frame
-	FRotator LastCameraRotation = FRotator(0, 0, 0);
+	//! Predictor of the camera pose at display time, fed with the rendered poses
+	FCameraPosePredictor PosePredictor;
 
-	//! Cached player location from the last frame
-	FVector LastCameraPosition = FVector(0, 0, 0);
+	//! Detector of the sudden camera motions, measured over a fixed time window
+	FMotionDetector MotionDetector;
 
 	//! The volume of the background music
 	float BgmAudioVolume = 1.0f;
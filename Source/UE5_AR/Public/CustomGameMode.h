@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ARTraceResult.h"
+#include "WorldCollision.h"
 #include "GameFramework/GameModeBase.h"
 #include "CustomGameMode.generated.h"
 
@@ -14,6 +15,11 @@ class AHelloARManager;
 class UCustomUserWidget;
 class USoundBase;
 
+//! @brief Delegate called with the results of an asynchronous touch line trace
+//! Parameters are the AR plane hits, the first hit actor and the direction of the traced line.
+//! The AR plane hits are only traced when no actor was hit.
+DECLARE_DELEGATE_ThreeParams(FOnTouchTraceDone, const TArray<FARTraceResult>&, const FHitResult&, const FVector&);
+
 //! @brief Enumerator specifying the different game states
 UENUM()
 enum EDisplayMode
@@ -39,6 +45,27 @@ struct FLayoutData
 	FTransform StaticMeshTransform;
 };
 
+//! @brief Structure holding the dormant scene of a display mode, resumed when the mode is shown again
+USTRUCT()
+struct FSuspendedScene
+{
+	GENERATED_BODY()
+
+	//! The gameplay plane of the scene
+	UPROPERTY()
+		AGameplayPlane* Plane = nullptr;
+
+	//! The other actors of the scene
+	UPROPERTY()
+		TArray<APlaceableActor*> Actors;
+
+	//! World time the scene was last shown at, the least recently shown scene is evicted first
+	float LastShownTime = 0.f;
+
+	//! Estimated memory held by the actors of the scene, in bytes
+	int64 EstimatedSize = 0;
+};
+
 //! @brief Class governing the application and holder of the global data
 UCLASS()
 class UE5_AR_API ACustomGameMode : public AGameModeBase
@@ -132,6 +159,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Game Functionality")
 		void AskForLineTrace(const FVector& ScreenPos, TArray<FARTraceResult>& TraceResults, FHitResult& TraceResultObj, FVector& DirectionResult);
 
+	//! @brief Function starting the same line trace as AskForLineTrace without stalling the game thread
+	//! The physics trace runs asynchronously, its result is consumed the next frame.
+	//! The AR plane hits of all the traces finished that frame are then traced together, only for the traces that hit no actor.
+	//! @param ScreenPos - The position of the touch in screen-space.
+	//! @param OnDone - Delegate called with the results the next frame.
+	void AskForAsyncLineTrace(const FVector& ScreenPos, const FOnTouchTraceDone& OnDone);
+
 	//! @brief Function to spawn a relevant gameplay plane at a given line trace result.
 	//! @param LineTraceHit - Validated AR line trace hit result.
 	//! @param Direction - Direction of the line trace.
@@ -174,10 +208,86 @@ public:
 	UPROPERTY(Category = "Settings", EditAnywhere, BlueprintReadWrite)
 		float ObjectLineTraceDistance = 1000.0f;
 
+	//! Whether the scene of a display mode is kept dormant when switching away from it, instead of being closed
+	UPROPERTY(Category = "Settings", EditAnywhere, BlueprintReadWrite)
+		bool bSuspendScenes = true;
+
+	//! Maximum number of dormant scenes kept at once, the least recently shown one is destroyed first
+	UPROPERTY(Category = "Settings", EditAnywhere, BlueprintReadWrite)
+		int MaxSuspendedScenes = 2;
+
+	//! Memory in kilobytes the dormant scenes may hold together, the least recently shown ones are destroyed until they fit
+	UPROPERTY(Category = "Settings", EditAnywhere, BlueprintReadWrite)
+		int SuspendedScenesBudgetKB = 512;
+
 protected:
 
+	//! @brief Structure of a touch line trace, pending until its physics trace is done
+	struct FTouchTrace
+	{
+		FVector2D ScreenPos = FVector2D::ZeroVector;
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		FVector Direction = FVector::ZeroVector;
+
+		//! Flag noting the trace ends on the gameplay plane, hit exactly if nothing is in front of it
+		bool bEndsOnPlane = false;
+
+		FHitResult HitResult;
+		FTraceHandle Handle;
+		FOnTouchTraceDone OnDone;
+		bool bIsDone = false;
+	};
+
 	//Hidden
 
+	//! @brief Function deprojecting the touch and finding the end of its line trace
+	//! @param ScreenPos - The position of the touch in screen-space.
+	//! @param OutQueryParams - [OUT] Parameters of the physics trace.
+	//! @returns [value] - The touch trace, without a hit result.
+	FTouchTrace MakeTouchTrace(const FVector2D& ScreenPos, FCollisionQueryParams& OutQueryParams) const;
+
+	//! @brief Function completing the hit result of the touch trace with the gameplay plane, if nothing was hit in front of it
+	//! @param Trace - [IN/OUT] The touch trace with the result of its physics trace.
+	//! @param bHitActor - Whether the physics trace hit an actor.
+	void FinishTouchTrace(FTouchTrace& Trace, const bool bHitActor) const;
+
+	//! @brief Callback of the asynchronous physics traces of the touches
+	//! @param Handle - Handle of the finished trace.
+	//! @param Datum - Results of the trace.
+	void OnAsyncTouchTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	//! @brief Function tracing the AR planes of the finished touch traces in one pass and calling their delegates
+	void ProcessTouchTraces();
+
+	//! @brief Function making the current scene dormant and storing it under the display mode
+	//! @param Mode - The display mode being left.
+	//! @param Actors - [IN/OUT] Active placeable actors, the suspended ones are taken out.
+	//! @returns true - If the scene got suspended.
+	//! @returns false - If suspending is disabled, there is no plane to suspend or the scene alone is over the budget, nothing is suspended then.
+	bool SuspendScene(const TEnumAsByte<EDisplayMode> Mode, TArray<APlaceableActor*>& Actors);
+
+	//! @brief Function waking up the scene stored under the display mode
+	//! @param Mode - The display mode being entered.
+	//! @returns true - If the scene was resumed.
+	//! @returns false - If no scene was stored or its plane no longer exists.
+	bool ResumeScene(const TEnumAsByte<EDisplayMode> Mode);
+
+	//! @brief Function destroying the scene stored under the display mode, if any
+	//! @param Mode - The display mode of the scene.
+	void EvictScene(const TEnumAsByte<EDisplayMode> Mode);
+
+	//! @brief Function checking whether one more dormant scene fits next to the stored ones
+	//! @param AddedSize - Estimated size of the added scene in bytes.
+	//! @returns true - If the scenes stay within MaxSuspendedScenes and SuspendedScenesBudgetKB.
+	//! @returns false - otherwise.
+	bool FitsSuspendedScenesBudget(const int64 AddedSize) const;
+
+	//! @brief Function estimating the memory held by the actor and its components
+	//! @param Actor - The actor to measure.
+	//! @returns [value] - Estimated size in bytes, 0 for an invalid actor.
+	static int64 EstimateActorSize(AActor* Actor);
+
 	//! Flag noting whether the AR plane and AR Pin have been determined
 	bool bPlaneDetermined = false;
 
@@ -204,4 +314,14 @@ protected:
 	//! The preserved house layout
 	UPROPERTY()
 		TArray<FLayoutData> StoredLayoutData = {};
+
+	//! The dormant scenes of the display modes not currently shown
+	UPROPERTY()
+		TMap<TEnumAsByte<EDisplayMode>, FSuspendedScene> SuspendedScenes;
+
+	//! The touch traces started by AskForAsyncLineTrace and not yet consumed
+	TArray<FTouchTrace> PendingTouchTraces;
+
+	//! Delegate of the asynchronous physics traces, bound once
+	FTraceDelegate TouchTraceDelegate;
 };
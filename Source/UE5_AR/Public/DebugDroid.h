@@ -29,4 +29,17 @@ public:
 	//! Distance in cm at which the colour changes
 	UPROPERTY(Category = "Debug Droid Colours", EditAnywhere, BlueprintReadWrite)
 		double MaxDistance = 100;
+
+protected:
+
+	//Hidden
+
+	//! Location the distance to the camera was last measured from
+	FVector MeasuredLocation = FVector::ZeroVector;
+
+	//! Flag noting the droid was close to the camera at the last measure
+	bool bIsClose = false;
+
+	//! Flag noting the colour of the material matches the last measure
+	bool bIsColourSet = false;
 };
@@ -4,13 +4,18 @@
 
 #include "CoreMinimal.h"
 #include "PlaceableActor.h"
-#include "Components/SphereComponent.h"
+#include "FishSwarm.h"
+#include "MaterialTimeline.h"
 #include "Fish.generated.h"
 
 class AFishingLure;
+class AFishingPond;
+class UFishSpeciesData;
 class USoundBase;
 
 //! @brief Class of the fishing pond fish actors
+//! While swimming the fish is simulated and drawn by the pond and the actor only mirrors the simulation
+//! Once reeled in, the actor takes over and ticks on its own
 UCLASS()
 class UE5_AR_API AFish : public APlaceableActor
 {
@@ -24,10 +29,6 @@ public:
 	UPROPERTY(Category = "Hierarchy", VisibleAnywhere, BlueprintReadWrite)
 		UStaticMeshComponent* RealFishMeshComponent = nullptr;
 
-	//! Collision sphere used for lure detection
-	UPROPERTY(Category = "Hierarchy", VisibleAnywhere, BlueprintReadWrite)
-		USphereComponent* SwimmingCollider = nullptr;
-
 	AFish();
 	//~AFish();
 
@@ -44,81 +45,80 @@ public:
 
 	// Assets
 
-	//! Actual 3D model of the fish, WITH applied material
+	//! Shared tuning values and assets of the fish species, assigned by the pond when the fish is added
 	UPROPERTY(Category = "Fish Assets", EditAnywhere, BlueprintReadWrite)
+		UFishSpeciesData* Species = nullptr;
+
+	// Constants
+
+	//! The class of the placeable actor representation of the fish to be placed in the house etc.
+	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+		TSubclassOf<APlaceableActor> PlaceableFishClass;
+
+	//! Whether the fish materials evaluate the "OpacityFactor" timeline on their own, otherwise it is written every frame of the fade
+	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+		bool bAnimateInMaterials = false;
+
+	// Deprecated
+
+	//! [DEPRECATED] Values of the fish blueprints made before the species data, turned into species by a pond without species
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the FishMesh of the species data."))
 		UStaticMesh* FishMesh = nullptr;
 
-	//! Particle effect for water splash
-	UPROPERTY(Category = "Fish Assets", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the SplashSfx of the species data."))
 		USoundBase* SplashSfx = nullptr;
 
-	//! Particle effect for water splash
-	UPROPERTY(Category = "Fish Assets", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the CaughtSfx of the species data."))
 		USoundBase* CaughtSfx = nullptr;
 
-	// Constants
-
-	//! Fade in animation custom factor, used in materials
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the FadeInOutSpeed of the species data."))
 		float FadeInOutSpeed = 1.0f;
 
-	//! The width of the silhouette, applied as a base static mesh transform
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the ScaleWidth of the species data."))
 		float ScaleWidth = 1.0f;
 
-	//! The height of the silhouette, applied as a base static mesh transform
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the ScaleHeight of the species data."))
 		float ScaleHeight = 1.0f;
 
-	//! The maximum angle offset fot the wiggle animation
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the MaxWiggleAngle of the species data."))
 		float MaxWiggleAngle = 1.0f;
 
-	//! The speed factor of the wiggle animation
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the WiggleSpeedFactor of the species data."))
 		float WiggleSpeedFactor = 0.25f;
 
-	//! Maximum speed the fish can swim
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the MaxSpeed of the species data."))
 		float MaxSpeed = 1.0f;
 
-	//! Maximum turning velocity the fish can turn per second
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the MaxAngularVelocity of the species data."))
 		float MaxAngularVelocity = 1.0f;
 
-	//! Maximum movement difference in a second for a lure to not break when catching fish
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the CatchingMovementRangeTop of the species data."))
 		float CatchingMovementRangeTop = 150;
 
-	//! Time interval in seconds for a fish to change the target position 
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the TargetChangeTime of the species data."))
 		float TargetChangeTime = 4.f;
 
-	//! The probability that the fish will choose the lure (if available) as its next target
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the ChoosingLureProbability of the species data."))
 		int ChoosingLureProbability = 30;
 
-	//! How close the fish can swim towards the target
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the LureDetectionRadius of the species data."))
 		float LureDetectionRadius = 35.f;
 
-	//! How many times the fish can change target before leaving the pond for good
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category = "Fish Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use the IterationLifespan of the species data."))
 		int IterationLifespan = 4;
 
-	//! The class of the placeable actor representation of the fish to be placed in the house etc.
-	UPROPERTY(Category = "Fish Cosntant", EditAnywhere, BlueprintReadWrite)
-		TSubclassOf<APlaceableActor> PlaceableFishClass;
-
 	// Functionality data
 
 	//! Flag noting whether the fish is guaranteed to escape reel in next frame
 	UPROPERTY(Category = "Fish Functionality", EditAnywhere, BlueprintReadWrite)
 		bool GuaranteeEscape = false;
 
-	//! The position relative to the center of the pond the fish is trying to reach
-	UPROPERTY(Category = "Fish Functionality", VisibleAnywhere, BlueprintReadWrite)
-		FVector RelativePointOfInterest;
+	//! Index of the fish in the pond simulation, INDEX_NONE when the fish is not simulated by the pond
+	int32 SwarmIndex = INDEX_NONE;
+
+	//! The pond the fish lives in, can be nullptr
+	UPROPERTY()
+		AFishingPond* OwningPond = nullptr;
 
 	// Events
 
@@ -131,45 +131,24 @@ public:
 	//! @param NewMode - The mode that the application is switching into.
 	virtual void OnDisplayModeChanged(const TEnumAsByte<EDisplayMode> NewMode) override;
 
+	//! @brief Function checking whether the fish can stay dormant in the pond when the display mode changes
+	//! @returns true - If the fish swims in the pond.
+	//! @returns false - If the fish is being reeled in or caught.
+	virtual bool CanBeSuspended() const override { return IsInSwarm() && Super::CanBeSuspended(); }
+
 	//! @brief Input event function called when the player moves suddenly
 	//! Called only when sudden movement is being tracked
-	//! @param MovementDelta - The direction of the movement in World space.
-	virtual void OnSuddenPlayerMove(const FVector& MovementDelta) override;
+	//! @param MovementVelocity - The sudden part of the player velocity in World space, units per second.
+	virtual void OnSuddenPlayerMove(const FVector& MovementVelocity) override;
 
 	//! @brief [UNUSED] Input event function called when the player rotates suddenly
 	//! Called only when sudden rotation is being tracked
-	//! @param RotationDelta - The rotation difference.
+	//! @param RotationDelta - The rotation of the player over the detection window.
 	virtual void OnSuddenPlayerRotate(const FRotator& RotationDelta) override;
 
-	//! @brief Collider response function on entry
-	//! @param OverlappedComp - Our component that got overlapped.
-	//! @param OtherActor - The actor that collided with us.
-	//! @param OtherComp - The component of the other actor that overlapped us.
-	//! @param OtherBodyIndex - Index of the other body.
-	//! @param bFromSweep - Whether the overlap was caused as a result of our teleportation.
-	//! @param SweepResult - HitResult of our teleportation movement.
-	UFUNCTION()
-		virtual void OnColliderEnter(
-			UPrimitiveComponent* OverlappedComp, 
-			AActor* OtherActor, 
-			UPrimitiveComponent* OtherComp, 
-			int32 OtherBodyIndex, 
-			bool bFromSweep, 
-			const FHitResult& SweepResult
-		);
-
-	//! @brief Collider response function on leave
-	//! @param OverlappedComp - Our component that got overlapped.
-	//! @param OtherActor - The actor that collided with us.
-	//! @param OtherComp - The component of the other actor that overlapped us.
-	//! @param OtherBodyIndex - Index of the other body.
-	UFUNCTION()
-		virtual void OnColliderLeave(
-			UPrimitiveComponent* OverlappedComp,
-			AActor* OtherActor,
-			UPrimitiveComponent* OtherComp,
-			int32 OtherBodyIndex
-		);
+	//! @brief Event function called when the fish is returned to the actor pool
+	//! Returns the fish state, pond links and animations to defaults
+	virtual void OnReleasedToPool() override;
 
 	// Functions
 
@@ -195,44 +174,60 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Fish Functionality")
 		bool ShouldNotRemoveFromWorld() const;
 
+	//! @brief Function that checks whether the fish is currently simulated by the pond
+	//! @returns true - If the pond simulates the fish.
+	//! @returns false - If the fish is being reeled in, caught or escaping.
+	UFUNCTION(BlueprintCallable, Category = "Fish Functionality")
+		bool IsInSwarm() const;
+
+	//! @brief Function that returns whether a lure is close enough to the fish to be noticed
+	//! @returns true - If a lure is in the vicinity.
+	//! @returns false - otherwise.
+	UFUNCTION(BlueprintCallable, Category = "Fish Functionality")
+		bool HasLureInVicinity() const { return IsValid(LureInVicinity); }
+
+	//! @brief Function setting the lure the fish noticed, detection is done by the pond
+	//! @param Lure - The lure in the vicinity, nullptr if none.
+	void SetLureInVicinity(AFishingLure* Lure) { LureInVicinity = Lure; }
+
+	//! @brief Function returning the current state of the fish, from the pond simulation if simulated
+	//! @returns [value] - The state of the fish.
+	EFishState::Type GetFishState() const;
+
+	//! @brief Function switching the fish to the given species, applies the species scale and mesh
+	//! @param InSpecies - The species data, an invalid one is ignored.
+	void SetSpecies(UFishSpeciesData* InSpecies);
+
+	//! @brief Function that applies the simulated state of the fish to the actor
+	//! Only moves the actor, the silhouette is drawn by the pond
+	//! @param SwarmRelativeTransform - Interpolated transform of the fish relative to the pond center.
+	//! @param PondTransform - World transform of the pond center.
+	void UpdateFromSwarm(const FTransform& SwarmRelativeTransform, const FTransform& PondTransform);
+
+	//! @brief Function that makes the actor draw its own silhouette, used once the pond stops drawing it
+	//! @param Opacity - The opacity the silhouette had in the pond.
+	void ShowOwnSilhouette(const float Opacity);
+
 protected:
 
 	//Hidden
 
-	//! @brief Update function moving the fish toward the point of interest on the pond
-	//! @param DeltaTime - Time between frames
-	virtual void MoveTowardsInterest(const float DeltaTime);
-
 	//! @brief Function that checks whether the fish should escape reel in or not.
 	//! Only used while being reeled in.
 	//! @returns true - If the fish should escape or is guaranteed to escape.
 	//! @returns false - otherwise.
 	virtual bool ShouldEscape();
 
-	float MockCoro_ConsiderChangingTarget_Timer = 0.f;
-	//! @brief Mocked coroutine function chencking and changing the fish target at the specified intervals
-	//! Variables above belong to the coroutine
-	//! Called in the Tick
-	//! @param DeltaTime - Time between frames.
-	void MockCoro_ConsiderChangingTarget(const float DeltaTime);
+	//! @brief Function making the fish escape, starts the fading out animation
+	//! Changes the fish state
+	void Escape();
 
-	float MockCoro_FadeInAnimation_CurrentOpacity = 0.f;
-	//! @brief Mocked coroutine function describing the fading in animation
-	//! Variables above belong to the coroutine
-	//! Called in the Tick
-	//! @param DeltaTime - Time between frames.
-	//! @returns true - If the animation is done.
-	//! @returns false - otherwise.
-	bool MockCoro_FadeInAnimation(const float DeltaTime);
+	//! @brief Function replacing the opacity animation of the fish and writing it to the material
+	//! @param InOpacityTimeline - The new opacity animation.
+	void SetOpacityTimeline(const FMaterialTimeline& InOpacityTimeline);
 
-	float MockCoro_FadeOutAnimation_CurrentOpacity = 1.f;
-	//! @brief Mocked coroutine function describing the fading out animation
-	//! Variables above belong to the coroutine
-	//! Called in the Tick
-	//! @param DeltaTime - Time between frames.
-	//! @returns true - If the animation is done.
-	//! @returns false - otherwise.
-	bool MockCoro_FadeOutAnimation(const float DeltaTime);
+	//! Opacity animation of the fish once it draws its own silhouette
+	FMaterialTimeline OpacityTimeline = FMaterialTimeline(0.f, 0.f, 1.f, 1.f);
 
 	bool MockCoro_ReelInAnimation_FirstRun = true;
 	//! @brief Mocked coroutine function describing the reeling in animation
@@ -243,39 +238,12 @@ protected:
 	//! @returns false - otherwise.
 	bool MockCoro_ReelInAnimation(const float DeltaTime);
 
-	float MockCoro_WiggleAnimation_SineInput = 0.f;
-	//! @brief Mocked coroutine function describing the wiggling animation
-	//! Variables above belong to the coroutine
-	//! Called in the Tick
-	//! @param DeltaTime - Time between frames.
-	void MockCoro_WiggleAnimation(const float DeltaTime);
-
-	//! @brief Enumerator describing the state of the fish
-	enum FishState
-	{
-		Entering,
-		Swimming,
-		Leaving,
-		ReelingIn,
-		Caught,
-		Escaped,
-
-		//Category flags
-		Interactive = ReelingIn
-	}State = Entering;
-
-	//! Current swimming speed of the fish in units per second
-	float Speed = 20;
-
-	//! Number of times the fish has changed the target
-	int Iterations = 0;
-
-	//! Current angular velocity of the fish per second
-	float ActualAngularVelocity = 1.f;
+	//! State of the fish once it is no longer simulated by the pond
+	EFishState::Type State = EFishState::Entering;
 
 	//Hidden properties
 
-	//! The pointer to the colliding fishing lure, can be nullptr
+	//! The pointer to the fishing lure noticed by the fish, can be nullptr
 	UPROPERTY()
 		AFishingLure* LureInVicinity = nullptr;
 
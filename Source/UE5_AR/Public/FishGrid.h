@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//! @brief Uniform grid of the fish positions in pond-local 2D space
+//! Built from scratch with a counting sort, cheap enough to rebuild every frame
+//! Answers radius queries for the lure, spook propagation and neighbour queries for avoidance
+class UE5_AR_API FFishGrid
+{
+public:
+
+	// Functions
+
+	//! @brief Function rebuilding the grid from the packed positions
+	//! @param PositionX - X components of the positions, relative to the pond center.
+	//! @param PositionY - Y components of the positions, relative to the pond center.
+	//! @param InCellSize - Size of a grid cell, should be close to the most common query radius.
+	void Build(const TArray<float>& PositionX, const TArray<float>& PositionY, const float InCellSize);
+
+	//! @brief Function emptying the grid, queries return nothing until the next build
+	void Reset();
+
+	//! @brief Function checking whether the grid was built and not reset since
+	//! @returns true - If the grid can be queried.
+	//! @returns false - otherwise.
+	bool IsBuilt() const { return CellStart.Num() > 0; }
+
+	//! @brief Function gathering the indices of the positions within the radius
+	//! @param X - X component of the query center, relative to the pond center.
+	//! @param Y - Y component of the query center, relative to the pond center.
+	//! @param Radius - Radius of the query.
+	//! @param OutIndices - [OUT] Indices of the positions within the radius, in no specific order.
+	void QueryRadius(const float X, const float Y, const float Radius, TArray<int32>& OutIndices) const;
+
+	//! @brief Function calling the callback for every position within the radius
+	//! @param X - X component of the query center, relative to the pond center.
+	//! @param Y - Y component of the query center, relative to the pond center.
+	//! @param Radius - Radius of the query.
+	//! @param Callback - Callable taking the index of the position and the squared distance to it.
+	template<typename CallbackType>
+	void ForEachInRadius(const float X, const float Y, const float Radius, CallbackType&& Callback) const
+	{
+		if (!IsBuilt())
+			return;
+
+		const int32 MinCellX = FMath::Max(0, CellCoordinate(X - Radius, OriginX));
+		const int32 MaxCellX = FMath::Min(CellsX - 1, CellCoordinate(X + Radius, OriginX));
+		const int32 MinCellY = FMath::Max(0, CellCoordinate(Y - Radius, OriginY));
+		const int32 MaxCellY = FMath::Min(CellsY - 1, CellCoordinate(Y + Radius, OriginY));
+		const float RadiusSquared = Radius * Radius;
+
+		for (int32 CellY = MinCellY; CellY <= MaxCellY; CellY++)
+		{
+			for (int32 CellX = MinCellX; CellX <= MaxCellX; CellX++)
+			{
+				const int32 Cell = CellY * CellsX + CellX;
+
+				for (int32 It = CellStart[Cell]; It < CellStart[Cell + 1]; It++)
+				{
+					const int32 Index = SortedIndices[It];
+					const float DistanceSquared = FMath::Square(SortedX[It] - X) + FMath::Square(SortedY[It] - Y);
+
+					if (DistanceSquared <= RadiusSquared)
+						Callback(Index, DistanceSquared);
+				}
+			}
+		}
+	}
+
+protected:
+
+	//Hidden
+
+	//! @brief Function converting a position component into a cell coordinate, not clamped
+	//! @param Value - The position component.
+	//! @param Origin - The grid origin on the same axis.
+	//! @returns [value] - The cell coordinate.
+	int32 CellCoordinate(const float Value, const float Origin) const
+	{
+		return FMath::FloorToInt((Value - Origin) * InverseCellSize);
+	}
+
+	//! Maximum number of cells on one axis, positions far outside the pond share the border cells
+	static constexpr int32 MaxCellsPerAxis = 64;
+
+	//! Grid placement and resolution
+	float OriginX = 0.f;
+	float OriginY = 0.f;
+	float InverseCellSize = 1.f;
+	int32 CellsX = 0;
+	int32 CellsY = 0;
+
+	//! Index of the first sorted entry of each cell, one extra entry closes the last cell
+	TArray<int32> CellStart;
+
+	//! Cell of each position, in the order of the packed arrays
+	TArray<int32> CellOfIndex;
+
+	//! Indices and positions sorted by cell
+	TArray<int32> SortedIndices;
+	TArray<float> SortedX;
+	TArray<float> SortedY;
+};
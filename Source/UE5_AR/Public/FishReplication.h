@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "FishReplication.generated.h"
+
+class AFishingPond;
+class FFishSwarm;
+struct FReplicatedFishArray;
+
+//! @brief Structure holding the quantized state of one swimming fish as sent by the server
+//! Positions are pond relative in 1/64 units, the yaw in 256 steps and the speed in whole units per second.
+//! Clients follow the path to the target on their own, the state is only sent again when it changes,
+//! when the target drifts from the sent one or after the keyframe time.
+USTRUCT()
+struct UE5_AR_API FReplicatedFish : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	// Functions
+
+	//! @brief Function quantizing the state of the fish into the structure
+	//! @param Swarm - Simulation of the fish.
+	//! @param Index - Valid index of the fish in the simulation.
+	void Write(const FFishSwarm& Swarm, const int32 Index);
+
+	//! @brief Function applying the quantized state to the fish, the fish continues on a path planned from it
+	//! @param Swarm - Replica simulation of the fish.
+	//! @param Index - Valid index of the fish in the simulation.
+	void Read(FFishSwarm& Swarm, const int32 Index) const;
+
+	//! @brief Function checking whether the clients would follow the fish too loosely with the sent state
+	//! @param Swarm - Simulation of the fish.
+	//! @param Index - Valid index of the fish in the simulation.
+	//! @param Tolerance - Distance the target may drift from the sent one, the avoidance moves the whole path.
+	//! @returns true - If the state or species changed or the target drifted beyond the tolerance.
+	//! @returns false - otherwise.
+	bool HasDiverged(const FFishSwarm& Swarm, const int32 Index, const float Tolerance) const;
+
+	//! @brief Function packing the structure into the network stream
+	//! @returns true - Always, the structure cannot fail to serialize.
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	// Events
+
+	//! @brief Event functions called on the clients once the item arrives, changes or goes away
+	//! @param InArraySerializer - The array holding the item.
+	void PostReplicatedAdd(const FReplicatedFishArray& InArraySerializer);
+	void PostReplicatedChange(const FReplicatedFishArray& InArraySerializer);
+	void PreReplicatedRemove(const FReplicatedFishArray& InArraySerializer);
+
+	// Constants
+
+	//! Largest distance from the pond center that can be sent, further positions are clamped
+	static constexpr float PositionExtent = 511.f;
+
+	//! Number of quantization steps per unit of the positions
+	static constexpr float PositionScale = 64.f;
+
+	//! Network id of the fish, matches FFishSwarm::NetId
+	uint16 Id = 0;
+
+	//! Index of the fish species in the pond
+	uint8 Species = 0;
+
+	//! EFishState::Type, sent in 3 bits
+	uint8 State = 0;
+
+	//! Quantized position and target relative to the pond center
+	int16 X = 0;
+	int16 Y = 0;
+	int16 TargetX = 0;
+	int16 TargetY = 0;
+
+	//! Quantized heading and swimming speed
+	uint8 Yaw = 0;
+	uint8 Speed = 0;
+
+	//! Time since the state was written, only used by the server
+	float Age = 0.f;
+
+	//Hidden
+
+	//! @brief Functions converting a pond relative coordinate to the sent value and back
+	static int16 QuantizePosition(const float Value);
+	static float DequantizePosition(const int16 Value);
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedFish> : public TStructOpsTypeTraitsBase2<FReplicatedFish>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+//! @brief Fast array of the swimming fish of a pond, only the changed fish are sent
+USTRUCT()
+struct UE5_AR_API FReplicatedFishArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	//! Replicated fish, in no particular order
+	UPROPERTY()
+		TArray<FReplicatedFish> Items;
+
+	//! Pond owning the array, receives the changes on the clients
+	UPROPERTY(NotReplicated)
+		AFishingPond* Pond = nullptr;
+
+	// Functions
+
+	//! @brief Function finding the item of a fish
+	//! @param Id - Network id of the fish.
+	//! @returns [value] - Pointer to the item, nullptr if the fish is not replicated.
+	FReplicatedFish* Find(const uint16 Id);
+
+	//! @brief Function removing the item of a fish, if there is one
+	//! @param Id - Network id of the fish.
+	void Remove(const uint16 Id);
+
+	//! @brief Function serializing the changes of the array
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FReplicatedFish, FReplicatedFishArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedFishArray> : public TStructOpsTypeTraitsBase2<FReplicatedFishArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "FishSwarm.h"
+#include "FishSpeciesData.generated.h"
+
+class AFish;
+class USoundBase;
+
+//! @brief Data asset describing one fish species, shared by all the fish of the species
+//! Holds the tuning values and assets once, the fish only keep a reference or an index to it
+UCLASS(BlueprintType)
+class UE5_AR_API UFishSpeciesData : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	// Assets
+
+	//! The fish actor class spawned for the species, its mesh and material are used for the silhouette
+	UPROPERTY(Category = "Fish Species Assets", EditAnywhere, BlueprintReadOnly)
+		TSubclassOf<AFish> FishClass;
+
+	//! Actual 3D model of the fish, WITH applied material
+	UPROPERTY(Category = "Fish Species Assets", EditAnywhere, BlueprintReadOnly)
+		UStaticMesh* FishMesh = nullptr;
+
+	//! Sound played on water splash
+	UPROPERTY(Category = "Fish Species Assets", EditAnywhere, BlueprintReadOnly)
+		USoundBase* SplashSfx = nullptr;
+
+	//! Sound played when the fish is caught
+	UPROPERTY(Category = "Fish Species Assets", EditAnywhere, BlueprintReadOnly)
+		USoundBase* CaughtSfx = nullptr;
+
+	// Constants
+
+	//! Fade in animation custom factor, used in materials
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float FadeInOutSpeed = 1.0f;
+
+	//! The width of the silhouette, applied as a base static mesh transform
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float ScaleWidth = 1.0f;
+
+	//! The height of the silhouette, applied as a base static mesh transform
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float ScaleHeight = 1.0f;
+
+	//! The maximum angle offset fot the wiggle animation
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float MaxWiggleAngle = 1.0f;
+
+	//! The speed factor of the wiggle animation
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float WiggleSpeedFactor = 0.25f;
+
+	//! Maximum speed the fish can swim
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float MaxSpeed = 1.0f;
+
+	//! Maximum turning velocity the fish can turn per second
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float MaxAngularVelocity = 1.0f;
+
+	//! Maximum movement difference in a second for a lure to not break when catching fish
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float CatchingMovementRangeTop = 150;
+
+	//! Time interval in seconds for a fish to change the target position
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float TargetChangeTime = 4.f;
+
+	//! The probability that the fish will choose the lure (if available) as its next target
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		int ChoosingLureProbability = 30;
+
+	//! How close the lure has to be for the fish to consider it as a target
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float LureDetectionRadius = 35.f;
+
+	//! How many times the fish can change target before leaving the pond for good
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		int IterationLifespan = 4;
+
+	//! Relative chance of the species to be picked when the pond spawns a fish, 0 never spawns it
+	UPROPERTY(Category = "Fish Species Constants", EditAnywhere, BlueprintReadOnly)
+		float SpawnWeight = 1.f;
+
+	// Functions
+
+	//! @brief Function gathering the tuning values used by the pond simulation
+	//! @returns [value] - Tuning values of the species.
+	FFishSwarmParams MakeSwarmParams() const;
+
+	//! @brief Function creating a transient species from the deprecated values of a fish class made before the species data
+	//! @param Outer - Owner of the created species, keeps it alive.
+	//! @param InFishClass - The fish class, its class defaults are copied.
+	//! @returns [value] - The created species.
+	//! @returns nullptr - If the fish class is not valid.
+	static UFishSpeciesData* CreateFromFishClass(UObject* Outer, const TSubclassOf<AFish> InFishClass);
+};
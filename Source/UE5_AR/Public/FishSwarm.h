@@ -0,0 +1,324 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FFishGrid;
+
+//! @brief Enumerator describing the state of a fish, shared by the pond simulation and the fish actors
+namespace EFishState
+{
+	enum Type : uint8
+	{
+		Entering,
+		Swimming,
+		Leaving,
+		ReelingIn,
+		Caught,
+		Escaped,
+
+		//Category flags
+		Interactive = ReelingIn
+	};
+}
+
+//! @brief Enumerator describing how much detail the simulation spends on a fish
+namespace EFishSignificance
+{
+	enum Type : uint8
+	{
+		//Far or off-screen fish, stepped at a reduced rate without the wiggle animation
+		Low,
+		//Visible or lure adjacent fish, stepped every simulation step
+		High,
+	};
+}
+
+//! @brief Structure encapsulating the tuning values of a fish species, shared by all fish of the species
+struct FFishSwarmParams
+{
+	//! Fade in animation custom factor
+	float FadeInOutSpeed = 1.0f;
+
+	//! The maximum angle offset fot the wiggle animation
+	float MaxWiggleAngle = 1.0f;
+
+	//! The speed factor of the wiggle animation
+	float WiggleSpeedFactor = 0.25f;
+
+	//! Maximum speed the fish can swim
+	float MaxSpeed = 1.0f;
+
+	//! Maximum turning velocity the fish can turn per second
+	float MaxAngularVelocity = 1.0f;
+
+	//! Time interval in seconds for a fish to change the target position
+	float TargetChangeTime = 4.f;
+
+	//! How close the lure has to be for the fish to consider it as a target
+	float LureDetectionRadius = 35.f;
+
+	//! The probability that the fish will choose the lure (if available) as its next target
+	int32 ChoosingLureProbability = 30;
+
+	//! How many times the fish can change target before leaving the pond for good
+	int32 IterationLifespan = 4;
+};
+
+//! @brief Pond owned fish simulation, keeping the state of all swimming fish in packed arrays
+//! All positions are relative to the center of the pond
+//! Fish are updated in a single pass, the fish actors only mirror the results
+class UE5_AR_API FFishSwarm
+{
+public:
+
+	// Functions
+
+	//! @brief Function setting the tuning values of the species, indexed by the species index of the fish
+	//! Has to be called before any fish is added
+	//! @param InSpeciesParams - Tuning values of every species.
+	void SetSpeciesParams(const TArray<FFishSwarmParams>& InSpeciesParams) { SpeciesParams = InSpeciesParams; }
+
+	//! @brief Function adding a new fish to the simulation
+	//! @param RelativePosition - The initial position relative to the center of the pond.
+	//! @param PointOfInterest - The first position the fish will target relative to the center of the pond.
+	//! @param InSpecies - Valid index of the species of the fish in the species params.
+	//! @returns [value] - Index of the new fish in the packed arrays.
+	int32 Add(const FVector& RelativePosition, const FVector& PointOfInterest, const uint8 InSpecies);
+
+	//! @brief Function removing a fish from the simulation
+	//! The last fish is moved into the freed slot, its index changes to the removed one
+	//! @param Index - Valid index of the fish to remove.
+	void RemoveAtSwap(const int32 Index);
+
+	//! @brief Function removing all fish from the simulation
+	void Empty();
+
+	//! @brief Function returning the number of simulated fish
+	//! @returns [value] - Number of fish in the packed arrays.
+	int32 Num() const { return State.Num(); }
+
+	//! @brief Function advancing all fish of the simulation by one frame
+	//! The fish are updated in parallel chunks, only the packed arrays are written, the owner applies the results
+	//! Low significance fish gather the time and only take a step every LowSignificanceInterval updates
+	//! @param DeltaTime - Time between frames.
+	//! @param LureRelativeLocation - Position of the desirable lure relative to the pond center, nullptr if not available.
+	//! @param OutFinished - [OUT] Indices of the fish that finished leaving the pond this frame, in ascending order.
+	void Update(const float DeltaTime, const FVector* LureRelativeLocation, TArray<int32>& OutFinished);
+
+	//! @brief Function pushing apart the fish that swim too close to each other
+	//! @param Grid - Grid built from the current positions.
+	//! @param Radius - Distance under which the fish start avoiding each other.
+	//! @param Strength - Push speed in units per second of two fish at the same position.
+	//! @param DeltaTime - Time between frames.
+	void ApplyAvoidance(const FFishGrid& Grid, const float Radius, const float Strength, const float DeltaTime);
+
+	//! @brief Function that makes the fish leave the pond
+	//! @param Index - Valid index of the fish.
+	void LeavePond(const int32 Index);
+
+	//! @brief Function that scares the fish away from the given source and makes it leave the pond
+	//! @param Index - Valid index of the fish.
+	//! @param RelativeSpookSource - Position of the spook source relative to the pond center.
+	//! @returns true - If the fish got spooked.
+	//! @returns false - If the fish is already leaving.
+	bool Spook(const int32 Index, const FVector& RelativeSpookSource);
+
+	//! @brief Function sending the fish towards a new target from its current position and heading
+	//! @param Index - Valid index of the fish.
+	//! @param InTargetX - Target position relative to the pond center.
+	//! @param InTargetY - Target position relative to the pond center.
+	void Retarget(const int32 Index, const float InTargetX, const float InTargetY);
+
+	//! @brief Function building the pond relative transform of the fish
+	//! @param Index - Valid index of the fish.
+	//! @returns [value] - The transform relative to the pond center.
+	FTransform GetRelativeTransform(const int32 Index) const;
+
+	//! @brief Function returning the tuning values of the fish species
+	//! @param Index - Valid index of the fish.
+	//! @returns [value] - Reference to the shared species tuning values.
+	const FFishSwarmParams& GetParams(const int32 Index) const { return SpeciesParams[Species[Index]]; }
+
+	//! @brief Function storing the current positions and headings as the previous simulation state
+	//! Called before every simulation step
+	void StorePreviousState();
+
+	//! @brief Function building the pond relative transform of the fish between the previous and the current state
+	//! Low significance fish are evaluated on their path with the time they gathered, they move smoothly between their steps
+	//! @param Index - Valid index of the fish.
+	//! @param Alpha - Interpolation factor, 0 for the previous state and 1 for the current one.
+	//! @param StepTime - Time of one simulation step.
+	//! @returns [value] - The interpolated transform relative to the pond center.
+	FTransform GetInterpolatedRelativeTransform(const int32 Index, const float Alpha, const float StepTime) const;
+
+	// Packed data
+
+	//! Relative position components of the fish
+	TArray<float> PositionX;
+	TArray<float> PositionY;
+	TArray<float> PositionZ;
+
+	//! Heading of the fish in degrees
+	TArray<float> Yaw;
+
+	//! Position and heading of the fish before the last simulation step
+	TArray<float> PreviousPositionX;
+	TArray<float> PreviousPositionY;
+	TArray<float> PreviousYaw;
+
+	//! Current swimming speed of the fish in units per second
+	TArray<float> Speed;
+
+	//! Current maximum turning velocity of the fish per second
+	TArray<float> MaxAngularVelocity;
+
+	//! Maximum speed the fish can swim, copied from the params for the steering kernel
+	TArray<float> MaxSpeed;
+
+	//! The position relative to the center of the pond the fish is trying to reach
+	TArray<float> TargetX;
+	TArray<float> TargetY;
+
+	//! Time since the last change of target
+	TArray<float> TargetChangeTimer;
+
+	//! Current opacity of the fish, used by materials
+	TArray<float> Opacity;
+
+	//! Input of the wiggle animation sine and the resulting yaw offset
+	TArray<float> WiggleSineInput;
+	TArray<float> WiggleYaw;
+
+	//! Wiggle animation constants, copied from the params for the steering kernel
+	TArray<float> WiggleSpeedFactor;
+	TArray<float> MaxWiggleAngle;
+
+	//! Xorshift state of the per fish random generator, never 0
+	TArray<uint32> RandomState;
+
+	//! Current state of the fish, EFishState::Type
+	TArray<uint8> State;
+
+	//! Number of times the fish has changed the target
+	TArray<uint8> Iterations;
+
+	//! Index of the fish species in the pond
+	TArray<uint8> Species;
+
+	//! Network id of the fish, stable across the swaps of the packed arrays, set by the owner
+	TArray<uint16> NetId;
+
+	//! Distance swum along the current path and the total length of the path
+	TArray<float> PathDistance;
+	TArray<float> PathLength;
+
+	//! Heading in degrees at the start of the path
+	TArray<float> PathStartYaw;
+
+	//! Turning arc at the start of the path, center, radius and angle of the start point around the center in radians
+	TArray<float> ArcCenterX;
+	TArray<float> ArcCenterY;
+	TArray<float> ArcRadius;
+	TArray<float> ArcStartAngle;
+
+	//! Signed curvature of the arc, positive turns towards +Y, and the length of the arc
+	TArray<float> ArcCurvature;
+	TArray<float> ArcLength;
+
+	//! Straight part of the path from the end of the arc through the target, start point, unit direction and heading in degrees
+	TArray<float> LineStartX;
+	TArray<float> LineStartY;
+	TArray<float> LineDirectionX;
+	TArray<float> LineDirectionY;
+	TArray<float> LineYaw;
+
+	//! Level of detail of the fish, EFishSignificance::Type, set by the owner before the update
+	TArray<uint8> Significance;
+
+	//! Time gathered by the low significance fish since their last step
+	TArray<float> PendingTime;
+
+	//! Number of updates between two steps of a low significance fish
+	int32 LowSignificanceInterval = 4;
+
+	//! Whether the simulation mirrors a remote one, the fish only follow their paths and fade
+	//! The target changes, state changes and removals come from the remote simulation
+	bool bIsReplica = false;
+
+	//! Largest distance of a target from the pond center on either axis, targets stay within the replicated range
+	static constexpr float TargetExtent = 500.f;
+
+protected:
+
+	//Hidden
+
+	//! Tuning values of the species, only read on state changes
+	TArray<FFishSwarmParams> SpeciesParams;
+
+	//! Reused buffers of the avoidance pass
+	TArray<float> AvoidanceX;
+	TArray<float> AvoidanceY;
+
+	//! Time each fish advances by in the current update, 0 for the fish skipping it
+	TArray<float> StepTime;
+
+	//! Number of updates so far, staggers the steps of the low significance fish
+	uint32 UpdateCounter = 0;
+
+	//! Fish that finished leaving in the current update, written by the workers and gathered afterwards
+	TArray<uint8> FinishedFlags;
+
+	//! @brief Function advancing a chunk of consecutive fish, safe to run in parallel with other chunks
+	//! @param First - Index of the first fish of the chunk, has to be a multiple of four.
+	//! @param Last - Index past the last fish of the chunk.
+	//! @param DeltaTime - Time between frames.
+	//! @param LureRelativeLocation - Position of the desirable lure, nullptr if not available.
+	void UpdateRange(const int32 First, const int32 Last, const float DeltaTime, const FVector* LureRelativeLocation);
+
+	//! @brief Function planning the swim path from the current position and heading to the target
+	//! The path is the tightest arc the maximum angular velocity allows followed by a line through the target
+	//! Called on every target change, the per step movement only evaluates the path
+	//! @param Index - Valid index of the fish.
+	void PlanPath(const int32 Index);
+
+	//! @brief Function evaluating the planned path of the fish
+	//! @param Index - Valid index of the fish.
+	//! @param Distance - Distance along the path.
+	//! @param OutX - [OUT] Relative position X component on the path.
+	//! @param OutY - [OUT] Relative position Y component on the path.
+	//! @param OutYaw - [OUT] Heading in degrees on the path.
+	void EvaluatePath(const int32 Index, const float Distance, float& OutX, float& OutY, float& OutYaw) const;
+
+	//! @brief Update function moving the fish along its path toward the point of interest
+	//! Scalar version of the steering kernel, used for the fish that do not fill a whole batch
+	//! @param Index - Valid index of the fish.
+	//! @param DeltaTime - Time the fish advances by.
+	void MoveTowardsInterest(const int32 Index, const float DeltaTime);
+
+	//! @brief Steering kernel moving four consecutive fish along their paths at once
+	//! Each lane advances by its own step time, batches where no fish is due are skipped
+	//! @param FirstIndex - Index of the first fish of the batch, the batch has to be within the arrays.
+	void MoveTowardsInterestBatch(const int32 FirstIndex);
+
+	//! @brief Function checking and changing the fish target at the specified intervals
+	//! @param Index - Valid index of the fish.
+	//! @param DeltaTime - Time between frames.
+	//! @param LureRelativeLocation - Position of the desirable lure, nullptr if not available.
+	void ConsiderChangingTarget(const int32 Index, const float DeltaTime, const FVector* LureRelativeLocation);
+
+	//! @brief Function describing the fading in animation
+	//! @param Index - Valid index of the fish.
+	//! @param DeltaTime - Time between frames.
+	//! @returns true - If the animation is done.
+	//! @returns false - otherwise.
+	bool FadeIn(const int32 Index, const float DeltaTime);
+
+	//! @brief Function describing the fading out animation
+	//! @param Index - Valid index of the fish.
+	//! @param DeltaTime - Time between frames.
+	//! @returns true - If the animation is done.
+	//! @returns false - otherwise.
+	bool FadeOut(const int32 Index, const float DeltaTime);
+};
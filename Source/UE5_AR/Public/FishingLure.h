@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "PlaceableActor.h"
+#include "FixedStepClock.h"
+#include "LateUpdateTickFunction.h"
+#include "CameraPoseTracker.h"
 #include "FishingLure.generated.h"
 
 class UNiagaraSystem;
@@ -30,6 +33,10 @@ protected:
 	// Called when the game starts or when spawned
 	//virtual void BeginPlay() override;
 
+	//! @brief Called to (un)register the tick functions, registers the late aim tick along the primary one
+	//! @param bRegister - Whether to register or unregister.
+	virtual void RegisterActorTickFunctions(bool bRegister) override;
+
 public:
 
 	//! @brief Called every frame
@@ -64,6 +71,14 @@ public:
 	UPROPERTY(Category = "Fishing Lure Constant", EditAnywhere, BlueprintReadWrite)
 		float FloatMovingSpeed = 50.0;
 
+	//! Number of lure simulation steps per second while casting and floating
+	UPROPERTY(Category = "Fishing Lure Constant", EditAnywhere, BlueprintReadWrite)
+		float SimulationRate = 30.0;
+
+	//! Maximum number of simulation steps in one frame, after a hitch the lure slows down instead of overshooting
+	UPROPERTY(Category = "Fishing Lure Constant", EditAnywhere, BlueprintReadWrite)
+		int MaxSimulationStepsPerFrame = 4;
+
 	// Events
 
 	//! @brief [DISABLED] Input event function used when the object is touched.
@@ -73,8 +88,12 @@ public:
 
 	//! @brief Input event function called when the player moves suddenly
 	//! Called only when sudden movement is being tracked
-	//! @param MovementDelta - The direction of the movement in World space.
-	virtual void OnSuddenPlayerMove(const FVector& MovementDelta) override;
+	//! @param MovementVelocity - The sudden part of the player velocity in World space, units per second.
+	virtual void OnSuddenPlayerMove(const FVector& MovementVelocity) override;
+
+	//! @brief Event function called when the lure is returned to the actor pool
+	//! Returns the lure state and animations to defaults
+	virtual void OnReleasedToPool() override;
 
 	// Functions
 
@@ -143,13 +162,40 @@ protected:
 	//! @param DeltaTime - Time between frames.
 	void MockCoro_FloatingAnimation(const float DeltaTime);
 
+	//! @brief Late update function aiming the lure with the camera pose the frame is rendered with
+	//! Called in the late aim tick, after the late update tick of the player
+	void LateAimUpdate();
+
 	//! @brief Function performing an update each frame the lure is in visualisation mode
 	//! Performs line trace and lure movement
 	void VisualisationUpdate();
 
 	//! @brief Function performing an update each frame the lure is in floating mode
+	//! Performs line trace for the point to float towards
+	void FloatingUpdate();
+
+	//! @brief Function finding the point of the gameplay plane the camera looks at
+	//! Intersects the plane disc directly, the physics trace is only used when the plane cannot be intersected
+	//! @param OutHitPosition - [OUT] World position of the aimed point, if any.
+	//! @returns true - If the camera looks at the gameplay plane.
+	//! @returns false - otherwise.
+	bool FindAimedPlanePoint(FVector& OutHitPosition) const;
+
+	//! @brief Function making ripples on the surface of the pond at the lure
+	//! @param Strength - Height of the ripples, 1 is a splash.
+	void DisturbPondSurface(const float Strength) const;
+
+	//! @brief Function performing an update each frame the lure is casting or floating
+	//! Advances the fixed step simulation and interpolates the rendered position
 	//! @param DeltaTime - Time between frames.
-	void FloatingUpdate(const float DeltaTime);
+	void SimulationUpdate(const float DeltaTime);
+
+	//! @brief Function taking one fixed simulation step of the floating lure
+	//! @param StepTime - Time of the simulation step.
+	void FloatTowardsTarget(const float StepTime);
+
+	//! @brief Function restarting the simulation from the current position
+	void ResetSimulation();
 
 	//! @brief Enumerator specifying the lure mode
 	enum LureState
@@ -159,9 +205,28 @@ protected:
 		Floating,
 	}State = Visualisation;
 
+	//! State the lure was aiming in last frame, a new state aims again
+	LureState AimedState = Visualisation;
+
+	//! Flag noting the aimed point was found for the current camera pose
+	bool bIsAimUpToDate = false;
+
+	//! Tick function aiming the lure after the camera manager update
+	FLateUpdateTickFunction LateAimTick;
+
+	//! Predicted camera pose the lure is aimed with
+	FCameraPoseTracker AimPose;
+
 	//! The position, relative to the pond center, where the lure should float to
 	FVector FloatTowardsPoint;
 
+	//! Clock splitting the frame time into the fixed simulation steps
+	FFixedStepClock SimulationClock;
+
+	//! Position relative to the pin before and after the last simulation step
+	FVector PreviousSimulatedLocation;
+	FVector SimulatedLocation;
+
 	//! Flag noting whether the lure is "in use"
 	bool bIsCatchingAFish = false;
 
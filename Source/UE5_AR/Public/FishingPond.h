@@ -5,9 +5,34 @@
 #include "CoreMinimal.h"
 #include "GameplayPlane.h"
 #include "Fish.h"
+#include "FishSwarm.h"
+#include "FishGrid.h"
+#include "FixedStepClock.h"
+#include "AliasTable.h"
+#include "SpawnDirector.h"
+#include "PondRippleSimulation.h"
 #include "FishingLure.h"
+#include "FishReplication.h"
 #include "FishingPond.generated.h"
 
+class UFishSpeciesData;
+class UInstancedStaticMeshComponent;
+class UTexture2D;
+
+//! @brief Indices of the per instance custom data of the fish silhouettes, read by the silhouette materials
+//! Only written if the materials read them, see AFishingPond::bSilhouettesReadCustomData
+namespace EFishSilhouetteData
+{
+	enum Type : int32
+	{
+		Opacity,
+		WigglePhase,
+
+		//Count of the custom data floats
+		Count
+	};
+}
+
 //! @brief Gameplay plane used for fishing state, handles the fishing minigame game logic 
 UCLASS()
 class UE5_AR_API AFishingPond : public AGameplayPlane
@@ -16,7 +41,15 @@ class UE5_AR_API AFishingPond : public AGameplayPlane
 
 public:
 
-	//AFishingPond();
+	// Hierarchy
+
+	//! Instanced silhouettes of the swimming fish, created on BeginPlay
+	//! One component per fish species, or per species and opacity level if the materials do not read the custom data
+	UPROPERTY(Category = "Hierarchy", VisibleAnywhere, BlueprintReadOnly)
+		TArray<UInstancedStaticMeshComponent*> SilhouetteComponents;
+
+	// Sets default values for this actor's properties
+	AFishingPond();
 	virtual ~AFishingPond() override;
 
 protected:
@@ -24,22 +57,51 @@ protected:
 	//! @brief Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	//! @brief Called when the pond is being removed from the world
+	//! Destroys the fish still simulated by the pond
+	//! @param EndPlayReason - Why the pond is being removed.
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
 
 	//! @brief Called every frame
 	//! @param DeltaTime - time difference between frames.
 	virtual void Tick(float DeltaTime) override;
 
+	//! @brief Function registering the replicated properties
+	//! @param OutLifetimeProps - [OUT] The replicated properties.
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	//! @brief Function adding the memory used by the pond, including the fish it simulates
+	//! @param CumulativeResourceSize - [IN/OUT] The accumulated resource size.
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	// Events
+
+	//! @brief Event function called on the clients when a fish arrives from the server or its state changes
+	//! @param Fish - The received state of the fish.
+	void OnReplicatedFishChanged(const FReplicatedFish& Fish);
+
+	//! @brief Event function called on the clients when the server removes a fish
+	//! @param Fish - The last received state of the fish.
+	void OnReplicatedFishRemoved(const FReplicatedFish& Fish);
+
+	//! @brief Function making the pond and its simulation dormant, stops the motion processing of the player
+	virtual void Suspend() override;
+
+	//! @brief Function waking the pond up where it was left, restarts the motion processing of the player
+	virtual void Resume() override;
+
 	// Functions
 
 	//! @brief Function that spawns a new fish in the lake and specifies its first target.
-	//! @param ClassIndex - Index of the stored fish class to spawn.
+	//! @param SpeciesIndex - Index of the stored fish species to spawn.
 	//! @param RelativePosition - The initial spawning position, relative to the center of the pond.
 	//! @param PointOfInterest - The fist position the fish will target relative to the center of the pond.
 	//! @returns [value] - Pointer to the spawned fish actor, if spawned.
 	//! @returns nullptr - otherwise. 
 	UFUNCTION(BlueprintCallable, Category = "Fishing Pond Functionality")
-		AFish* AddFish(const int ClassIndex, const FVector& RelativePosition, const FVector& PointOfInterest = FVector(0,1, 0));
+		AFish* AddFish(const int SpeciesIndex, const FVector& RelativePosition, const FVector& PointOfInterest = FVector(0,1, 0));
 
 	//! @brief Remove the provided fish from the lake by destroying it.
 	//! Used to keep track of the fish in the pond.
@@ -48,6 +110,39 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Fishing Pond Functionality")
 		void RemoveFish(AFish* FishToRemove);
 
+	//! @brief Function that takes the fish out of the pond simulation, the fish actor ticks on its own afterwards.
+	//! Used when the fish starts being reeled in, the fish still counts as present in the pond.
+	//! @param FishToDetach - Fish actor simulated by this pond.
+	UFUNCTION(BlueprintCallable, Category = "Fishing Pond Functionality")
+		void DetachFish(AFish* FishToDetach);
+
+	//! @brief Function returning the world transform of the pond center, all fish positions are relative to it.
+	//! @returns [value] - The pin transform if available, actor transform otherwise.
+	UFUNCTION(BlueprintCallable, Category = "Fishing Pond Functionality")
+		FTransform GetPondTransform() const;
+
+	//! @brief Function returning the simulation of the swimming fish
+	//! @returns [value] - Reference to the pond fish simulation.
+	FFishSwarm& GetSwarm() { return Swarm; }
+
+	//! @brief Function returning the spatial grid of the swimming fish, rebuilt if the simulation changed since the last build
+	//! @returns [value] - Reference to the grid indexed like the simulation.
+	const FFishGrid& GetFishGrid();
+
+	//! @brief Function that spooks a swimming fish and spreads the panic to the fish around it
+	//! @param Index - Valid index of the fish in the simulation.
+	//! @param RelativeSpookSource - Position of the spook source relative to the pond center.
+	//! @returns true - If the fish got spooked.
+	//! @returns false - If the fish was already leaving.
+	bool SpookSwarmFish(const int32 Index, const FVector& RelativeSpookSource);
+
+	//! @brief Function making ripples on the pond surface
+	//! @param RelativePosition - Position of the disturbance relative to the pond center.
+	//! @param Strength - Height of the disturbance, 1 is a splash.
+	//! @param Radius - Radius of the disturbance, relative to the pond center.
+	UFUNCTION(BlueprintCallable, Category = "Fishing Pond Functionality")
+		void DisturbSurface(const FVector& RelativePosition, const float Strength = 1.f, const float Radius = 6.f);
+
 	//! @brief Function to gather the position of the lure in the pond, if it can be gathered.
 	//! @param LureRelativeLocation - [OUT] Reference used to return the lure position, if available.
 	//! @returns true - if the position can be/was gathered.
@@ -57,8 +152,12 @@ public:
 
 	// Assets
 
-	//! The array of fish classes spawnable on the lake
+	//! The array of fish species spawnable on the lake, at most 256
 	UPROPERTY(Category = "Fishing Pond Assets", EditAnywhere, BlueprintReadWrite)
+		TArray<UFishSpeciesData*> FishSpecies;
+
+	//! [DEPRECATED] The array of fish classes spawnable on the lake, turned into transient species on BeginPlay if there are no species
+	UPROPERTY(Category = "Fishing Pond Deprecated", EditDefaultsOnly, meta = (DeprecatedProperty, DeprecationMessage = "Use FishSpecies."))
 		TArray<TSubclassOf<AFish>> FishClasses;
 
 	//! The blueprint class of the lure object to spawn
@@ -67,35 +166,228 @@ public:
 
 	// Constants
 
-	//! Maximum number of fish at a time in the pond
+	//! Maximum number of fish at a time in the pond, swimming fish are simulated by the pond so this can be in hundreds
 	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
 		int MaxFish = 5;
 
-	//! Time interval for the pond to try to spawn new fish
+	//! Number of fish the pond keeps even when the device is over the frame budget
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		int MinFish = 2;
+
+	//! Time interval for the pond to spawn or send away a fish while the population is close to its target
 	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
 		float FishSpawnTime = 2.f;
 
+	//! Targeted frame time in milliseconds, the fish population grows while the frames are well below it and shrinks above it
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float FrameTimeBudget = 33.3f;
+
 	//! Maximum number of caught fish in the temporary inventory
 	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
 		int MaxCaughtFishCapacity = 3;
 
+	//! Number of fish of each species spawned into the actor pool upfront, capped by MaxFish
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		int PrewarmedFishPerClass = 8;
+
+	//! Number of fish simulation steps per second, the rendering is interpolated between the steps
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float SimulationRate = 30.f;
+
+	//! Maximum number of simulation steps in one frame, after a hitch the fish slow down instead of teleporting
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		int MaxSimulationStepsPerFrame = 4;
+
+	//! Size of a cell of the fish grid, should be close to the most common query radius
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float FishGridCellSize = 20.f;
+
+	//! How far from a spooked fish the other fish get spooked as well
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float SpookPropagationRadius = 30.f;
+
+	//! Distance under which the fish start swimming away from each other
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float FishAvoidanceRadius = 8.f;
+
+	//! Push speed of two fish at the same position, 0 disables the avoidance
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float FishAvoidanceStrength = 20.f;
+
+	//! Distance from the camera under which the visible fish are simulated in full detail
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float SignificanceCameraDistance = 150.f;
+
+	//! Half angle in degrees of the camera view cone, fish outside of it are simulated in low detail
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float SignificanceViewAngle = 45.f;
+
+	//! Distance from the lure under which the fish are always simulated in full detail
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float SignificanceLureDistance = 70.f;
+
+	//! Number of simulation steps between two steps of a low detail fish
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		int LowSignificanceInterval = 4;
+
+	//! Whether the silhouette materials read the opacity and wiggle phase from the per instance custom data
+	//! Otherwise the fish are drawn through a dynamic material per species and opacity level, and wiggled by rotation
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		bool bSilhouettesReadCustomData = false;
+
+	//! Number of opacity levels the fading fish are drawn with when the materials do not read the custom data
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		int SilhouetteOpacityLevels = 8;
+
+	//! Resolution of the ripple simulation for each effects quality level, from low to cinematic
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		TArray<int> RippleResolutionPerQuality = { 32, 48, 64, 96 };
+
+	//! Number of ripple simulation steps per second
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float RippleSimulationRate = 30.f;
+
+	//! Fraction of the ripple height kept every simulation step
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float RippleDamping = 0.97f;
+
+	//! Half of the side of the square covered by the ripples, relative to the pond center, written to the materials as "RippleExtent"
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float RippleExtent = 120.f;
+
+	//! Number of times per second the server looks for fish states worth sending to the clients
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float ReplicationRate = 5.f;
+
+	//! Distance the target of a fish may drift from the sent one before the state is sent again
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float ReplicationTolerance = 2.f;
+
+	//! Time in seconds after which the state of a fish is sent again even if it did not change, corrects the drift of the clients
+	UPROPERTY(Category = "Fishing Pond Constants", EditAnywhere, BlueprintReadOnly)
+		float ReplicationKeyframeTime = 2.f;
+
 protected:
 
 	//Hidden
 
-	float MockCoro_FishSpawner_Timer = 0.f;
-	//! @brief Mocked coroutine function spawning the fish at given intervals
-	//! Variables above belong to the coroutine
-	//! Called in the Tick
+	//! @brief Update function growing or shrinking the fish population as decided by the spawn director
+	//! Spawned species are picked by their spawn weights, the fish sent away are preferably the low detail ones
 	//! @param DeltaTime - Time between frames.
-	void MockCoro_FishSpawner(const float DeltaTime); 
+	void UpdatePopulation(const float DeltaTime);
+
+	//! @brief Update function advancing the fish simulation and mirroring it onto the fish actors
+	//! @param DeltaTime - Time between frames.
+	void UpdateSwarm(const float DeltaTime);
+
+	//! @brief Update function writing the fish states the clients follow too loosely into the replicated array
+	//! Runs on the server at the replication rate, only the written fish are sent
+	//! @param DeltaTime - Time between frames.
+	void UpdateReplication(const float DeltaTime);
+
+	//! @brief Function ranking the fish by the distance to the camera, the camera view cone and the distance to the lure
+	//! Far or off-screen fish are simulated in low detail, fish close to the lure always in full detail
+	//! @param PondTransform - World transform of the pond center.
+	void UpdateSignificance(const FTransform& PondTransform);
+
+	//! @brief Function taking one fixed simulation step of the fish
+	//! @param StepTime - Time of the simulation step.
+	void SimulateSwarm(const float StepTime);
+
+	//! @brief Function finding the fish close enough to the lure to notice it
+	//! A spooky lure spooks the fish instead
+	//! @returns true - If at least one fish noticed the lure.
+	//! @returns false - otherwise.
+	bool UpdateFishNearLure();
+
+	//! @brief Function creating the instanced silhouette components of each fish species
+	//! Without materials reading the custom data, one component with its own dynamic material is created per opacity level
+	void CreateSilhouetteComponents();
+
+	//! @brief Function setting up the ripple simulation for the device quality and handing its texture to the materials
+	void CreateRipples();
+
+	//! @brief Update function advancing the ripple simulation and uploading its latest result to the texture
+	//! @param DeltaTime - Time between frames.
+	void UpdateRipples(const float DeltaTime);
+
+	//! @brief Update function mirroring the fish simulation onto the instanced silhouettes
+	//! Instances are only added or removed when the number of fish of a species changes
+	//! @param PondTransform - World transform of the pond center.
+	void UpdateSilhouettes(const FTransform& PondTransform);
+
+	//! @brief Function removing a fish from the simulation, keeping the fish actor indices in sync
+	//! @param Index - Valid index of the fish in the simulation.
+	//! @param bDestroyActor - Whether the fish actor should be destroyed as well.
+	void RemoveSwarmFishAt(const int32 Index, const bool bDestroyActor);
 
 	//! The number of fish currently present in the pond
 	int CurrentFishCount = 0;
 
+	//! Director adapting the fish population to the frame time
+	FSpawnDirector SpawnDirector;
+
+	//! Spawn weights of the fish species, indices match the species array
+	FAliasTable SpeciesTable;
+
+	//! Packed simulation of all swimming fish
+	FFishSwarm Swarm;
+
+	//! Clock splitting the frame time into the fixed simulation steps
+	FFixedStepClock SimulationClock;
+
+	//! Interpolated pond relative transforms of the fish for the current frame
+	TArray<FTransform> InterpolatedTransforms;
+
+	//! Spatial grid of the swimming fish, indexed like the simulation
+	FFishGrid FishGrid;
+
+	//! Flag noting the simulation changed since the grid was built
+	bool bIsFishGridDirty = true;
+
+	//! Largest lure detection radius among the fish added to the pond
+	float MaxLureDetectionRadius = 0.f;
+
+	//! Simulation indices of the fish that noticed the lure last update
+	TArray<int32> FishNearLure;
+
+	//! Ripples on the pond surface, simulated on a worker thread
+	FPondRippleSimulation RippleSimulation;
+
+	//! Reused buffers of the silhouette instance update
+	TArray<FTransform> SilhouetteTransforms;
+	TArray<float> SilhouetteData;
+
+	//! Simulation indices of the fish drawn by each silhouette component, filled in one pass over the simulation
+	TArray<TArray<int32>> SilhouetteBuckets;
+
+	//! Number of instances of each silhouette component drawing a fish last update, the others are hidden and kept for reuse
+	TArray<int32> SilhouetteShownCounts;
+
+	//! Number of silhouette components per species, the opacity levels drawn through dynamic materials
+	int32 SilhouetteLevels = 1;
+
+	//! Time since the replicated fish states were last checked
+	float ReplicationTimer = 0.f;
+
+	//! Network id of the next fish added on the server
+	uint16 NextFishNetId = 1;
+
 	//Hidden properties
 
 	//! Pointer to the fishing lure object
 	UPROPERTY()
 		AFishingLure* PlayerLure = nullptr;
+
+	//! Heights of the ripples read by the pond materials as "RippleTexture", 128 is still water
+	UPROPERTY()
+		UTexture2D* RippleTexture = nullptr;
+
+	//! The fish actors mirroring the simulation, indices match the simulation indices, nullptr on the clients
+	UPROPERTY()
+		TArray<AFish*> SwarmFish;
+
+	//! Quantized states of the swimming fish, written by the server and followed by the clients
+	UPROPERTY(Replicated)
+		FReplicatedFishArray ReplicatedFish;
 };
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//! @brief Clock splitting the frame time into fixed simulation steps
+//! The leftover time is kept for the next frame and used to interpolate the rendered state between the last two steps
+//! Catch-up is capped, after a hitch the simulation slows down instead of taking huge or countless steps
+class UE5_AR_API FFixedStepClock
+{
+public:
+
+	//! @brief Constructor of the clock
+	//! @param InRate - Number of simulation steps per second.
+	//! @param InMaxStepsPerFrame - Maximum number of steps taken in one frame.
+	explicit FFixedStepClock(const float InRate = 30.f, const int32 InMaxStepsPerFrame = 4);
+
+	// Functions
+
+	//! @brief Function changing the rate of the simulation, resets the clock
+	//! @param InRate - Number of simulation steps per second, has to be positive.
+	//! @param InMaxStepsPerFrame - Maximum number of steps taken in one frame.
+	void SetRate(const float InRate, const int32 InMaxStepsPerFrame);
+
+	//! @brief Function advancing the clock by the frame time
+	//! @param DeltaTime - Time between frames.
+	//! @returns [value] - Number of simulation steps to take this frame.
+	int32 Advance(const float DeltaTime);
+
+	//! @brief Function dropping the leftover time, used when the simulation restarts
+	void Reset() { Accumulator = 0.f; }
+
+	//! @brief Function returning the time of one simulation step
+	//! @returns [value] - Step time in seconds.
+	float GetStepTime() const { return StepTime; }
+
+	//! @brief Function returning how far the frame is between the last two simulation steps
+	//! @returns [0,1) - Interpolation factor from the previous to the current simulation state.
+	float GetAlpha() const { return Accumulator / StepTime; }
+
+protected:
+
+	//Hidden
+
+	//! Time of one simulation step
+	float StepTime = 1.f / 30.f;
+
+	//! Maximum number of steps taken in one frame
+	int32 MaxStepsPerFrame = 4;
+
+	//! Frame time not yet consumed by the simulation steps
+	float Accumulator = 0.f;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "PlaceableActor.h"
+#include "MaterialTimeline.h"
 #include "GameplayPlane.generated.h"
 
 //! @brief Class representing the basic functionality of a gameplay plane, holds the game logic and visual representation
@@ -63,6 +64,11 @@ public:
 	//! @param NewMode - The mode that the application is switching into.
 	virtual void OnDisplayModeChanged(const TEnumAsByte<EDisplayMode> NewMode) override;
 
+	//! @brief Function checking whether the plane can stay dormant when the display mode changes
+	//! @returns true - If the plane is not closing.
+	//! @returns false - otherwise.
+	virtual bool CanBeSuspended() const override { return !bIsClosing && Super::CanBeSuspended(); }
+
 	// Functions
 
 	//! @brief Function called to help the player determine if the object can be added to UI as a member
@@ -72,6 +78,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Gameplay Plane Functionality")
 		virtual bool CanAddMeshToUI() { return false; };
 
+	//! @brief Function intersecting a ray with the disc of the plane, answered exactly without a physics query
+	//! @param RayOrigin - World position the ray starts at.
+	//! @param RayDirection - Normalized world direction of the ray.
+	//! @param MaxDistance - Length of the ray.
+	//! @param OutHitPosition - [OUT] World position of the hit, if any.
+	//! @returns true - If the ray hits the disc, from either side.
+	//! @returns false - otherwise.
+	bool IntersectRay(const FVector& RayOrigin, const FVector& RayDirection, const float MaxDistance, FVector& OutHitPosition) const;
+
+	//! @brief Function checking whether the disc of the plane is known and rays can be intersected with it
+	//! @returns true - If the plane mesh is set.
+	//! @returns false - otherwise, a physics trace has to be used instead.
+	bool CanIntersectRay() const { return DiscRadius > 0.f; }
+
 	// Constants
 
 	//! Scaling factor of the spawned plane on XY scale, Z is ignored
@@ -106,6 +126,11 @@ public:
 	UPROPERTY(Category = "Gameplay Plane Constants", EditAnywhere, BlueprintReadOnly)
 		float TexturePlaneEdgeSize = 1.2f;
 
+	//! Whether the materials evaluate the growth and closing animations from the timeline parameters on their own
+	//! Otherwise the animated values are written to the materials every frame of the animation
+	UPROPERTY(Category = "Gameplay Plane Constants", EditAnywhere, BlueprintReadOnly)
+		bool bAnimateInMaterials = false;
+
 	// Assets
 
 	//! Static mesh asset of a plane
@@ -128,25 +153,28 @@ protected:
 
 	//Hidden
 
-	float MockCoro_InitialAnimation_UVRadius = 0.f;
-	float MockCoro_InitialAnimation_CurrentOverallGradient = 1.f;
-	//! @brief Mocked coroutine function describing the initial ring growth animation
-	//! Variables above belong to the coroutine
-	//! Called in the Tick
-	//! @param DeltaTime - Time between frames.
-	//! @returns true - If the animation is done.
-	//! @returns false - otherwise.
-	bool MockCoro_InitialAnimation(const float DeltaTime);
-
-	float MockCoro_EndingProcess_UVRadius = 1.f;
-	float MockCoro_EndingProcess_CurrentOverallGradient = 1.f;
-	//! @brief Mocked coroutine function describing the closing ring animation
-	//! Variables above belong to the coroutine
-	//! Called in the Tick
-	//! @param DeltaTime - Time between frames.
-	//! @returns true - If the animation is done.
-	//! @returns false - otherwise.
-	bool MockCoro_EndingAnimation(const float DeltaTime);
+	//! @brief Function starting the initial ring growth animation, the ring gradient fades once the ring is grown
+	//! The animations are written to the materials once, the Tick only checks whether they are over
+	void StartInitialAnimation();
+
+	//! @brief Function starting the closing ring animation from the current state of the animations
+	void StartEndingAnimation();
+
+	//! @brief Function writing the current values of the animations to the materials
+	//! Only used when the materials do not evaluate the animations on their own
+	void UpdateAnimatedValues();
+
+	//! Center of the plane disc in the space of the plane mesh
+	FVector DiscCenter = FVector::ZeroVector;
+
+	//! Radius of the plane disc in the space of the plane mesh, 0 if unknown
+	float DiscRadius = 0.f;
+
+	//! Animation of the "UVDiameter" of the plane and the texture plane materials
+	FMaterialTimeline DiameterTimeline;
+
+	//! Animation of the "OverallGradientIntensity" of the ring material
+	FMaterialTimeline GradientTimeline;
 
 	//! Flag noting the initialised status
 	bool bIsInitialised = false;
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputCoreTypes.h"
+
+//! @brief Enumerator describing the gestures recognized from the touches
+namespace ETouchGesture
+{
+	enum Type : uint8
+	{
+		None,
+		//Short touch of one finger that did not move
+		Tap,
+		//One finger moving, reported on every move
+		Drag,
+		//Two fingers moving, reported on every move with the change of their distance and angle
+		Pinch
+	};
+}
+
+//! @brief Structure describing a recognized gesture
+struct FTouchGesture
+{
+	//! Type of the gesture
+	ETouchGesture::Type Type = ETouchGesture::None;
+
+	//! Screen position of the tap or drag, the middle of the fingers of a pinch
+	FVector2D Position = FVector2D::ZeroVector;
+
+	//! Change of the distance between the fingers since the last pinch move, 1 for no change
+	float Scale = 1.f;
+
+	//! Change of the angle between the fingers since the last pinch move, in degrees, clockwise on screen
+	float Rotation = 0.f;
+};
+
+//! @brief Recognizer of taps, drags and pinches, driven by the touch events of all fingers
+//! Every event is timestamped when it arrives, the touch state is never polled.
+//! Two fingers down turn the touch into a pinch, no tap or drag is reported until all fingers are lifted.
+class UE5_AR_API FGestureRecognizer
+{
+public:
+
+	// Events
+
+	//! @brief Event function called when a finger touches the screen
+	//! @param Finger - Index of the finger.
+	//! @param Position - Screen position of the touch.
+	//! @param Time - Timestamp of the event in seconds.
+	//! @returns [value] - The recognized gesture, None when it is too early to tell.
+	FTouchGesture OnTouchPressed(const ETouchIndex::Type Finger, const FVector2D& Position, const double Time);
+
+	//! @brief Event function called when a finger moves on the screen
+	//! @param Finger - Index of the finger.
+	//! @param Position - Screen position of the touch.
+	//! @param Time - Timestamp of the event in seconds.
+	//! @returns [value] - A drag or pinch, None for a finger still within the drag distance.
+	FTouchGesture OnTouchMoved(const ETouchIndex::Type Finger, const FVector2D& Position, const double Time);
+
+	//! @brief Event function called when a finger leaves the screen
+	//! @param Finger - Index of the finger.
+	//! @param Position - Screen position of the touch.
+	//! @param Time - Timestamp of the event in seconds.
+	//! @returns [value] - A tap if the touch was short and still, None otherwise.
+	FTouchGesture OnTouchReleased(const ETouchIndex::Type Finger, const FVector2D& Position, const double Time);
+
+	// Functions
+
+	//! @brief Function forgetting all touches
+	void Reset();
+
+	//! @brief Function returning the ongoing drag, the finger may be held still
+	//! @param OutFinger - [OUT] Index of the dragging finger.
+	//! @param OutPosition - [OUT] Last screen position of the dragging finger.
+	//! @returns true - If a single finger is dragging.
+	//! @returns false - otherwise.
+	bool GetDrag(ETouchIndex::Type& OutFinger, FVector2D& OutPosition) const;
+
+	// Constants
+
+	//! Distance in pixels a finger has to move before the touch becomes a drag
+	float DragDistance = 10.f;
+
+	//! Longest duration in seconds of a touch still counting as a tap
+	float TapTime = 0.3f;
+
+protected:
+
+	//! @brief Structure of the state of one finger
+	struct FTouchPoint
+	{
+		bool bIsDown = false;
+		FVector2D StartPosition = FVector2D::ZeroVector;
+		FVector2D Position = FVector2D::ZeroVector;
+		double StartTime = 0.0;
+	};
+
+	//Hidden
+
+	//! @brief Function finding the first two fingers on the screen
+	//! @param OutFirst - [OUT] Index of the first finger.
+	//! @param OutSecond - [OUT] Index of the second finger.
+	//! @returns true - If at least two fingers are down.
+	//! @returns false - otherwise.
+	bool FindPinchFingers(int32& OutFirst, int32& OutSecond) const;
+
+	//! @brief Function storing the distance and angle between the pinching fingers as the base of the next move
+	void StorePinchBase();
+
+	//! State of the fingers, indexed by the touch index
+	FTouchPoint Touches[ETouchIndex::MAX_TOUCHES];
+
+	//! Number of fingers on the screen
+	int32 TouchCount = 0;
+
+	//! Flag noting the single finger touch became a drag
+	bool bIsDragging = false;
+
+	//! Flag noting two fingers were down since all fingers were last lifted
+	bool bWasPinching = false;
+
+	//! Distance and angle in degrees between the pinching fingers at the last pinch move
+	float PinchDistance = 0.f;
+	float PinchAngle = 0.f;
+};
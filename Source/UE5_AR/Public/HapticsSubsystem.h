@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "HapticsSubsystem.generated.h"
+
+//! @brief Enumerator describing the priority of a force feedback request, higher priorities override the lower ones
+namespace EHapticPriority
+{
+	enum Type : uint8
+	{
+		//Background feedback, e.g. fish around the lure
+		Ambient,
+		//Feedback of an ongoing interaction, e.g. reeling in a fish
+		Interaction,
+
+		//Count of the priorities
+		Count
+	};
+}
+
+//! @brief World subsystem merging the force feedback requests of the frame into a single update of the player controller
+//! The strongest request of the highest priority wins, the controller is only updated when the result changes
+//! or the running feedback is about to run out
+UCLASS()
+class UE5_AR_API UHapticsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//! @brief Called every frame, sends the merged requests of the frame
+	//! @param DeltaTime - time difference between frames.
+	virtual void Tick(float DeltaTime) override;
+
+	//! @brief Function returning the stat id of the subsystem tick
+	virtual TStatId GetStatId() const override;
+
+	// Functions
+
+	//! @brief Function requesting force feedback for the current frame, has to be repeated every frame it should last
+	//! @param Intensity - Strength of the feedback, from 0 to 1.
+	//! @param Priority - Priority of the request.
+	void RequestForceFeedback(const float Intensity, const EHapticPriority::Type Priority = EHapticPriority::Ambient);
+
+	//! @brief Convenience function requesting force feedback from the subsystem of the world
+	//! @param WorldContext - Any object of the world.
+	//! @param Intensity - Strength of the feedback, from 0 to 1.
+	//! @param Priority - Priority of the request.
+	static void RequestForceFeedback(const UObject* WorldContext, const float Intensity, const EHapticPriority::Type Priority = EHapticPriority::Ambient);
+
+	// Constants
+
+	//! Duration of the feedback sent to the controller, refreshed while it is requested
+	static constexpr float FeedbackDuration = 0.2f;
+
+	//! Minimum time between two updates of the controller
+	static constexpr float MinUpdateInterval = 0.05f;
+
+	//! Smallest intensity change worth an update of the controller
+	static constexpr float IntensityTolerance = 0.05f;
+
+protected:
+
+	//Hidden
+
+	//! Strongest request of each priority in the current frame
+	float RequestedIntensity[EHapticPriority::Count] = {};
+
+	//! Intensity of the feedback currently playing, 0 if none
+	float SentIntensity = 0.f;
+
+	//! Time since the last update of the controller
+	float TimeSinceUpdate = 0.f;
+
+	//! Handle of the feedback currently playing, 0 if none
+	FDynamicForceFeedbackHandle FeedbackHandle = 0;
+};
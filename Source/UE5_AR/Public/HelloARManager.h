@@ -79,4 +79,7 @@ protected:
 	//! Array of colours fo the planes
 	TArray<FColor> PlaneColors;
 
+	//! Number of plane actors spawned into the actor pool upfront
+	int PrewarmedPlaneActors = 8;
+
 };
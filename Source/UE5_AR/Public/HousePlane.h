@@ -45,6 +45,9 @@ public:
 	//! @param TouchPositionWorld - 2D position of the touch in screen-space.
 	virtual void OnDrag(const FVector& TouchPositionWorld) override;
 
+	//! @brief Function making the house dormant, saves the layout first in case the house gets evicted while suspended
+	virtual void Suspend() override;
+
 	// Functions
 
 	//! @brief Function called to help the player determine if the object can be added to UI as a member
@@ -90,14 +93,17 @@ protected:
 
 	//Hidden
 
-	float MockCoro_HouseIntroAnimation_Completion = 0.f;
-	//! @brief Mocked coroutine function describing the falling house intro animation
-	//! Variables above belong to the coroutine
-	//! Called in the Tick
-	//! @param DeltaTime - Time between frames.
-	//! @returns true - If the animation is done.
-	//! @returns false - otherwise.
-	bool MockCoro_HouseIntroAnimation(const float DeltaTime);
+	//! @brief Function starting the falling house intro animation
+	//! With material animations the house is placed at its final transform and the materials offset it until the end
+	void StartHouseIntroAnimation();
+
+	//! @brief Function moving the house mesh along the intro animation
+	//! Only used when the materials do not evaluate the animation on their own
+	//! @param Time - World time in seconds.
+	void UpdateHouseIntroTransform(const float Time);
+
+	//! Animation of the remaining part of the intro, from 1 at the start to 0 at the end
+	FMaterialTimeline HouseIntroTimeline;
 
 	//! @brief Function that accesses stored layout and spawns the objects back to scene with correct transforms
 	void LoadLayout();
@@ -113,4 +119,10 @@ protected:
 
 	//! Flag noting whehter the house plane is initialized
 	bool bIsHouseInitialized = false;
+
+	//Hidden properties
+
+	//! Modifiable material instances applied to the house mesh, animating the intro
+	UPROPERTY()
+		TArray<UMaterialInstanceDynamic*> HouseActualMaterials;
 };
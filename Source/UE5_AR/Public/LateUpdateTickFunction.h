@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "LateUpdateTickFunction.generated.h"
+
+//! @brief Secondary tick function of an actor, ticking after the player camera got its pose of the frame
+//! The camera managers are updated after all the actor ticks, the AR camera pose read in Tick is the one of the last frame.
+//! Work placed relative to the camera in this tick uses the pose the frame is rendered with.
+USTRUCT()
+struct UE5_AR_API FLateUpdateTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	FLateUpdateTickFunction();
+
+	//! @brief Function registering the tick function with the level of the actor
+	//! @param Owner - Actor owning the tick function, nothing is called once it is gone.
+	//! @param InUpdate - Function called in the tick with the frame time.
+	void Register(AActor* Owner, TFunction<void(float)>&& InUpdate);
+
+	//! @brief Function unregistering the tick function, if registered
+	void Unregister();
+
+	//! @brief Function called by the tick task manager
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	//! @brief Function describing the tick function for the diagnostics
+	//! @returns [value] - Name of the owner.
+	virtual FString DiagnosticMessage() override;
+
+protected:
+
+	//Hidden
+
+	//! The actor owning the tick function
+	TWeakObjectPtr<AActor> Target;
+
+	//! Function called in the tick
+	TFunction<void(float)> Update;
+};
+
+template<>
+struct TStructOpsTypeTraits<FLateUpdateTickFunction> : public TStructOpsTypeTraitsBase2<FLateUpdateTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
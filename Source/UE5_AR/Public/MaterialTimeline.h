@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMaterialInstanceDynamic;
+
+//! @brief Animation of a single value between two values, evaluated from the world time
+//! The whole timeline is written to a material once, the material evaluates it from the scene time:
+//! Value = lerp(From, To, pow(saturate((Time - StartTime) / Duration), Exponent))
+//! Materials without the timeline parameters can still be animated by writing the evaluated value every frame
+struct UE5_AR_API FMaterialTimeline
+{
+	//! World time in seconds the animation starts at
+	float StartTime = 0.f;
+
+	//! Length of the animation in seconds
+	float Duration = 0.f;
+
+	//! Values at the start and at the end of the animation
+	float From = 0.f;
+	float To = 0.f;
+
+	//! Shape of the animation curve, 1 is linear, above 1 eases in, below 1 eases out
+	float Exponent = 1.f;
+
+	FMaterialTimeline() = default;
+
+	//! @brief Constructor of the timeline
+	//! @param InStartTime - World time in seconds the animation starts at.
+	//! @param InDuration - Length of the animation in seconds, 0 or less jumps straight to the end value.
+	//! @param InFrom - Value at the start of the animation.
+	//! @param InTo - Value at the end of the animation.
+	//! @param InExponent - Shape of the animation curve, 1 is linear.
+	FMaterialTimeline(const float InStartTime, const float InDuration, const float InFrom, const float InTo, const float InExponent = 1.f);
+
+	// Functions
+
+	//! @brief Function evaluating the animated value, same as the material does
+	//! @param Time - World time in seconds.
+	//! @returns [value] - The animated value at the given time.
+	float Evaluate(const float Time) const;
+
+	//! @brief Function returning the world time the animation ends at
+	//! @returns [value] - End time in seconds.
+	float GetEndTime() const { return StartTime + FMath::Max(Duration, 0.f); }
+
+	//! @brief Function checking whether the animation reached its end value
+	//! @param Time - World time in seconds.
+	//! @returns true - If the animation is over.
+	//! @returns false - otherwise.
+	bool IsFinished(const float Time) const { return Time >= GetEndTime(); }
+
+	//! @brief Function writing the whole timeline to the material, once per animation
+	//! Sets the [Parameter]StartTime, [Parameter]Duration, [Parameter]From, [Parameter]To and [Parameter]Exponent scalar parameters
+	//! @param Material - Material to write to, can be nullptr.
+	//! @param Parameter - Base name of the animated parameter.
+	void WriteTo(UMaterialInstanceDynamic* Material, const FName& Parameter) const;
+
+	//! @brief Function writing the evaluated value to the material, used by materials without the timeline parameters
+	//! @param Material - Material to write to, can be nullptr.
+	//! @param Parameter - Name of the animated parameter.
+	//! @param Time - World time in seconds.
+	void WriteValueTo(UMaterialInstanceDynamic* Material, const FName& Parameter, const float Time) const;
+};
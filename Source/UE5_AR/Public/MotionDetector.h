@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//! @brief Detector of sudden camera movements and rotations, independent of the frame rate
+//! Keeps a ring buffer of timestamped camera poses and measures the velocities over a fixed time window.
+//! The slow part of the motion is removed by a high-pass filter, so walking or panning does not count as sudden.
+//! A detection fires once when the filtered speed crosses the threshold and re-arms only after it drops well below it.
+class UE5_AR_API FMotionDetector
+{
+public:
+
+	// Functions
+
+	//! @brief Update function adding the camera pose of the frame and detecting the sudden motions
+	//! @param Time - Timestamp of the pose in seconds, has to grow.
+	//! @param CameraTransform - World transform of the camera.
+	void AddPose(const double Time, const FTransform& CameraTransform);
+
+	//! @brief Function forgetting the poses and the filter state, the next poses start a new history
+	void Reset();
+
+	//! @brief Function setting the speeds above which the motions are sudden
+	//! @param InMovementThreshold - Speed of the camera movement in units per second.
+	//! @param InRotationThreshold - Angular speed of the camera in degrees per second.
+	void SetThresholds(const float InMovementThreshold, const float InRotationThreshold);
+
+	//! @brief Function checking whether a sudden movement was detected with the last pose
+	//! @returns true - If the filtered speed just crossed the movement threshold.
+	//! @returns false - otherwise.
+	bool HasSuddenMovement() const { return bHasSuddenMovement; }
+
+	//! @brief Function checking whether a sudden rotation was detected with the last pose
+	//! @returns true - If the filtered angular speed just crossed the rotation threshold.
+	//! @returns false - otherwise.
+	bool HasSuddenRotation() const { return bHasSuddenRotation; }
+
+	//! @brief Function returning the camera velocity over the detection window, without the slow motion
+	//! @returns [value] - World space velocity in units per second.
+	const FVector& GetVelocity() const { return Velocity; }
+
+	//! @brief Function returning the camera rotation over the detection window
+	//! @returns [value] - Rotation from the oldest to the newest pose of the window.
+	const FRotator& GetWindowRotation() const { return WindowRotation; }
+
+	// Constants
+
+	//! Number of poses kept, enough to cover the window at 240 frames per second
+	static constexpr int32 Capacity = 64;
+
+	//! Length of the window the velocities are measured over, bounds the detection latency
+	static constexpr double DetectionWindow = 0.1;
+
+	//! Time constant of the high-pass filter, slower motions are ignored
+	static constexpr float HighPassTime = 0.5f;
+
+	//! Fraction of the threshold the filtered speed has to drop below before the next detection
+	static constexpr float ReleaseRatio = 0.6f;
+
+protected:
+
+	//! @brief Structure of a timestamped camera pose
+	struct FMotionSample
+	{
+		double Time = 0.0;
+		FVector Location = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+	};
+
+	//Hidden
+
+	//! @brief Function returning a pose of the buffer
+	//! @param Age - Number of poses back from the newest, below the number of poses.
+	//! @returns [value] - Reference to the pose.
+	const FMotionSample& GetSample(const int32 Age) const { return Samples[(Head - Age + Capacity) % Capacity]; }
+
+	//! Ring buffer of the poses, Head is the newest one
+	FMotionSample Samples[Capacity];
+	int32 Head = 0;
+	int32 Count = 0;
+
+	//! Speeds above which the motions are sudden, in units and degrees per second
+	float MovementThreshold = 25.f;
+	float RotationThreshold = 180.f;
+
+	//! Low-passed velocities, subtracted from the measured ones
+	FVector SlowVelocity = FVector::ZeroVector;
+	FVector SlowAngularVelocity = FVector::ZeroVector;
+
+	//! Filtered velocity and the rotation over the window of the last pose
+	FVector Velocity = FVector::ZeroVector;
+	FRotator WindowRotation = FRotator::ZeroRotator;
+
+	//! Flags of the detections of the last pose
+	bool bHasSuddenMovement = false;
+	bool bHasSuddenRotation = false;
+
+	//! Flags noting the detections are re-armed
+	bool bIsMovementArmed = true;
+	bool bIsRotationArmed = true;
+};
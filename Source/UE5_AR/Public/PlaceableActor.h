@@ -5,6 +5,7 @@
 
 #include "GameFramework/Actor.h"
 #include "CustomGameMode.h"
+#include "ActorPoolSubsystem.h"
 #include "PlaceableActor.generated.h"
 
 class UARPin;
@@ -13,7 +14,7 @@ class UNiagaraSystem;
 
 //! @brief Base class for AR spawnable Actors, handles interaction with AR manager
 UCLASS()
-class UE5_AR_API APlaceableActor : public AActor
+class UE5_AR_API APlaceableActor : public AActor, public IPoolableActor
 {
 	GENERATED_BODY()
 
@@ -105,13 +106,13 @@ public:
 
 	//! @brief Input event function called when the player moves suddenly
 	//! Called only when sudden movement is being tracked
-	//! @param MovementDelta - The direction of the movement in World space.
+	//! @param MovementVelocity - The sudden part of the player velocity in World space, units per second.
 	UFUNCTION(BlueprintCallable, Category = "Placeable Actor Events")
-		virtual void OnSuddenPlayerMove(const FVector& MovementDelta) {};
+		virtual void OnSuddenPlayerMove(const FVector& MovementVelocity) {};
 
 	//! @brief [UNUSED] Input event function called when the player rotates suddenly
 	//! Called only when sudden rotation is being tracked
-	//! @param RotationDelta - The rotation difference.
+	//! @param RotationDelta - The rotation of the player over the detection window.
 	UFUNCTION(BlueprintCallable, Category = "Placeable Actor Events")
 		virtual void OnSuddenPlayerRotate(const FRotator& RotationDelta) {};
 
@@ -120,6 +121,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Placeable Actor Events")
 		virtual void OnDisplayModeChanged(const TEnumAsByte<EDisplayMode> NewMode);
 
+	//! @brief Event function called when the actor is reused from the actor pool
+	//! Plays the spawn effects a fresh actor would play on BeginPlay
+	virtual void OnAcquiredFromPool() override;
+
+	//! @brief Event function called when the actor is returned to the actor pool
+	//! Deselects the actor, leaves the UI and returns the pin, transform and material to defaults
+	virtual void OnReleasedToPool() override;
+
+	//! @brief Function checking whether the actor can stay dormant in its scene when the display mode changes
+	//! Actors that cannot are told about the new mode through OnDisplayModeChanged instead
+	//! @returns true - If the actor can be suspended.
+	//! @returns false - If the actor is part of the UI and follows the player.
+	virtual bool CanBeSuspended() const { return !bIsUIMember; }
+
+	//! @brief Function making the actor dormant while its scene is suspended: hidden, without collision and tick
+	//! The previous state is kept for Resume()
+	virtual void Suspend();
+
+	//! @brief Function waking the actor up when its scene is shown again, restores the state from before Suspend()
+	virtual void Resume();
+
 	// Functions
 
 	//! @brief Function used to select an item, including highlighting it.
@@ -158,6 +180,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Placeable Actor States")
 		bool GetIsUIMember() const { return bIsUIMember; };
 
+	//! @brief Function accessing the pool status of the object
+	//! @returns true - If the object is deactivated in the actor pool and should be ignored
+	//!	@returns false - otherwise
+	UFUNCTION(BlueprintCallable, Category = "Placeable Actor States")
+		bool IsInPool() const { return bIsInPool; };
+
+	//! @brief Function accessing the suspended status of the object
+	//! @returns true - If the object is dormant in a suspended scene and should be ignored
+	//!	@returns false - otherwise
+	UFUNCTION(BlueprintCallable, Category = "Placeable Actor States")
+		bool IsSuspended() const { return bIsSuspended; };
+
 protected:
 
 	//! @brief Update function called when the object is part of the UI
@@ -172,6 +206,23 @@ protected:
 	//! Flag noting the UI member status
 	bool bIsUIMember = false;
 
+	//! Flag noting the UI member transform was placed relative to the camera it is attached to
+	bool bIsUITransformUpToDate = false;
+
+	//! Flag noting the actor is deactivated in the actor pool
+	bool bIsInPool = false;
+
+	//! Flag noting the actor is dormant in a suspended scene
+	bool bIsSuspended = false;
+
+	//! State of the actor before it was suspended, restored on resume
+	bool bWasHiddenBeforeSuspend = false;
+	bool bWasCollisionEnabledBeforeSuspend = true;
+	bool bWasTickEnabledBeforeSuspend = true;
+
+	//! Relative transform of the static mesh after BeginPlay, restored when released to the actor pool
+	FTransform InitialMeshTransform;
+
 	// Hidden properties
 	
 	//! Pointer to the player managing the UI members
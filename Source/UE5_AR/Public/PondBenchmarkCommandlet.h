@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PondBenchmarkCommandlet.generated.h"
+
+class ACustomARPawn;
+class FJsonObject;
+
+//! @brief Commandlet measuring the cost of the fishing mode without a device or an AR session
+//! Spawns a fishing pond, fills it with fish and moves the camera by a script: aim, cast, float, tug to catch, jerk to spook.
+//! The frame times, allocations and actor churn of the measured frames are written as JSON. Runs headless:
+//! UnrealEditor-Cmd UE5_AR.uproject -run=PondBenchmark -nullrhi [-Fish=10 -Frames=3000 -Output=Path.json]
+//! Other parameters: -Pond=, -Pawn= class paths, -Warmup=, -DeltaTime=, -Tug=, -Jerk= speeds in cm/s, -Seed=
+UCLASS()
+class UE5_AR_API UPondBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UPondBenchmarkCommandlet();
+
+	//! @brief Entry point of the commandlet, sets up the world, runs the script and writes the results
+	//! @param Params - Command line of the commandlet.
+	//! @returns 0 - If the benchmark ran.
+	//! @returns 1 - If the pond or the player could not be set up.
+	virtual int32 Main(const FString& Params) override;
+
+	// Constants
+
+	//! Number of frames in one cycle of the script
+	static constexpr int32 CycleFrames = 240;
+
+	//! Frame of the cycle the lure is cast at
+	static constexpr int32 CastFrame = 20;
+
+	//! Frame of the cycle the camera is tugged at, catches the fish noticing the floating lure
+	static constexpr int32 TugFrame = 150;
+
+	//! Frame of the cycle the camera is jerked at, spooks the swimming fish
+	static constexpr int32 JerkFrame = 210;
+
+	//! Radius and height in cm of the camera orbit around the pond center
+	static constexpr float OrbitRadius = 150.f;
+	static constexpr float OrbitHeight = 100.f;
+
+	//! Speed of the camera orbit in degrees per second, slow enough not to count as a sudden move
+	static constexpr float OrbitSpeed = 5.f;
+
+	//! Radius in cm of the circle the camera aims at, the lure follows it
+	static constexpr float AimRadius = 40.f;
+
+	//! Radius in cm of the area the fish are spawned in
+	static constexpr float SpawnRadius = 100.f;
+
+	//! Duration in seconds of the tug and the jerk, the camera goes up and back at their speed
+	static constexpr float ImpulseTime = 0.2f;
+
+protected:
+
+	//Hidden
+
+	//! @brief Function placing the camera for a frame of the script
+	//! @param Player - Player whose camera is moved.
+	//! @param Frame - Index of the frame from the start of the script.
+	void UpdateCamera(ACustomARPawn* Player, const int32 Frame) const;
+
+	//! @brief Function summarizing samples into the mean, percentiles and maximum
+	//! @param Values - Samples, sorted by the function.
+	//! @returns [value] - JSON object with the summary.
+	static TSharedRef<FJsonObject> MakeDistribution(TArray<double>& Values);
+
+	//! @brief Function returning a percentile of sorted samples
+	//! @param Sorted - Samples in ascending order.
+	//! @param Percent - Percentile from 0 to 100.
+	//! @returns [value] - The sample at the percentile, 0 without samples.
+	static double Percentile(const TArray<double>& Sorted, const double Percent);
+
+	//! Length of a frame in seconds
+	float DeltaTime = 1.f / 30.f;
+
+	//! Speed in cm/s of the tug and the jerk of the camera
+	float TugSpeed = 40.f;
+	float JerkSpeed = 600.f;
+};
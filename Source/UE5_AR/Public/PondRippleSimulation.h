@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FixedStepClock.h"
+#include "Tasks/Task.h"
+
+//! @brief Heightfield simulation of the ripples on the pond surface, stepped at a fixed rate on a worker thread
+//! The square surface is stored row by row with a border of still water around it, two height buffers are swapped each step.
+//! Four cells are updated at once, a step reads the four neighbours of the current heights and the previous heights:
+//! Next = (Left + Right + Up + Down) / 2 - Previous, damped a little every step
+//! The game thread only adds impulses and takes the finished pixels, it never waits for the worker
+class UE5_AR_API FPondRippleSimulation
+{
+public:
+
+	//! @brief Destructor, waits for the running step to finish
+	~FPondRippleSimulation();
+
+	// Functions
+
+	//! @brief Function setting up the surface, waits for the running step first
+	//! @param InResolution - Number of cells along one side, rounded up to a multiple of 4.
+	//! @param InRate - Number of simulation steps per second.
+	//! @param InDamping - Fraction of the height kept every step, below 1.
+	void Initialize(const int32 InResolution, const float InRate, const float InDamping);
+
+	//! @brief Function disturbing the surface, applied before the next step
+	//! @param U - Horizontal position on the surface, from 0 to 1.
+	//! @param V - Vertical position on the surface, from 0 to 1.
+	//! @param Strength - Height added at the center of the disturbance, negative pushes the surface down.
+	//! @param Radius - Radius of the disturbance as a fraction of the surface side.
+	void AddImpulse(const float U, const float V, const float Strength, const float Radius);
+
+	//! @brief Update function collecting the finished steps and launching the next ones
+	//! @param DeltaTime - Time between frames.
+	//! @returns true - If new pixels are available.
+	//! @returns false - otherwise.
+	bool Update(const float DeltaTime);
+
+	//! @brief Function waiting for the running steps to finish
+	void Wait();
+
+	//! @brief Function returning the surface heights of the last finished step
+	//! @returns [value] - One byte per cell, row by row, 128 is still water.
+	const TArray<uint8>& GetPixels() const { return Pixels; }
+
+	//! @brief Function returning the number of cells along one side of the surface
+	//! @returns [value] - Resolution of the pixels.
+	int32 GetResolution() const { return Resolution; }
+
+	// Constants
+
+	//! Maximum number of steps caught up in one run of the worker, after a hitch the ripples slow down instead
+	static constexpr int32 MaxStepsPerRun = 4;
+
+	//! Height under which the whole surface counts as still, the worker is not launched for a still surface
+	static constexpr float RestHeight = 1.f / 256.f;
+
+protected:
+
+	//! @brief Structure describing a disturbance of the surface, in cells
+	struct FRippleImpulse
+	{
+		float X = 0.f;
+		float Y = 0.f;
+		float Strength = 0.f;
+		float Radius = 0.f;
+	};
+
+	//Hidden
+
+	//! @brief Function running on the worker, applies the impulses, takes the steps and writes the pixels
+	//! @param Steps - Number of simulation steps to take.
+	//! @param Impulses - Disturbances to apply before the steps.
+	void Run(const int32 Steps, const TArray<FRippleImpulse>& Impulses);
+
+	//! @brief Function taking one simulation step over the whole surface
+	//! @returns [value] - Largest absolute height of the new surface.
+	float Step();
+
+	//! Number of cells along one side of the surface, a multiple of 4
+	int32 Resolution = 0;
+
+	//! Number of floats in one row of the buffers, the surface plus the border
+	int32 Stride = 0;
+
+	//! Fraction of the height kept every step
+	float Damping = 0.98f;
+
+	//! Current and previous heights, swapped every step, the borders stay 0
+	TArray<float> CurrentHeights;
+	TArray<float> PreviousHeights;
+
+	//! Pixels written by the worker, swapped with the published pixels once the worker is done
+	TArray<uint8> WorkerPixels;
+
+	//! Pixels of the last finished step, owned by the game thread
+	TArray<uint8> Pixels;
+
+	//! Disturbances added since the last launch of the worker
+	TArray<FRippleImpulse> PendingImpulses;
+
+	//! Clock splitting the frame time into the fixed simulation steps
+	FFixedStepClock Clock;
+
+	//! Steps due but not yet taken
+	int32 PendingSteps = 0;
+
+	//! Flag noting the surface was still at the end of the last run, written by the worker
+	bool bIsAtRest = true;
+
+	//! The running steps of the worker, if any
+	UE::Tasks::FTask Task;
+};
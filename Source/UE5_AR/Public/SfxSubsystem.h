@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SfxSubsystem.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+
+//! @brief World subsystem playing one-shot sounds through a fixed set of pre-allocated audio components
+//! Requests are gathered during the frame and played together at its end:
+//! the same sound requested close to itself is played once, sounds too far from the listener are dropped,
+//! each sound has a limit of voices and the oldest voice is reused when all of them are busy
+UCLASS()
+class UE5_AR_API USfxSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//! @brief Called once the world begins play, allocates the voices
+	//! @param InWorld - The world of the subsystem.
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	//! @brief Called every frame, plays the requests of the frame
+	//! @param DeltaTime - time difference between frames.
+	virtual void Tick(float DeltaTime) override;
+
+	//! @brief Function returning the stat id of the subsystem tick
+	virtual TStatId GetStatId() const override;
+
+	// Functions
+
+	//! @brief Function requesting a one-shot sound, played at the end of the frame
+	//! @param Sound - Sound asset to play, can be nullptr.
+	//! @param Location - World location of the sound.
+	//! @param VolumeMultiplier - Volume of the sound.
+	void PlaySound(USoundBase* Sound, const FVector& Location, const float VolumeMultiplier = 1.f);
+
+	//! @brief Convenience function requesting a one-shot sound from the subsystem of the world
+	//! Plays the sound directly if the subsystem is not available
+	//! @param WorldContext - Any object of the world.
+	//! @param Sound - Sound asset to play, can be nullptr.
+	//! @param Location - World location of the sound.
+	//! @param VolumeMultiplier - Volume of the sound.
+	static void PlaySoundAtLocation(const UObject* WorldContext, USoundBase* Sound, const FVector& Location, const float VolumeMultiplier = 1.f);
+
+	// Constants
+
+	//! Number of pre-allocated audio components, the upper limit of sounds playing at once
+	static constexpr int32 MaxVoices = 12;
+
+	//! Maximum number of voices playing the same sound at once
+	static constexpr int32 MaxVoicesPerSound = 3;
+
+	//! Requests of the same sound closer than this to each other in one frame are played once
+	static constexpr float CoalesceRadius = 50.f;
+
+	//! Requests further than this from the listener are not played
+	static constexpr float MaxAudibleDistance = 3000.f;
+
+protected:
+
+	//! @brief Structure describing a sound requested in the current frame
+	struct FSfxRequest
+	{
+		TWeakObjectPtr<USoundBase> Sound;
+		FVector Location;
+		float VolumeMultiplier = 1.f;
+	};
+
+	//Hidden
+
+	//! @brief Function finding the voice to play a new sound on
+	//! @param Sound - The sound to play.
+	//! @returns [value] - Index of a free voice, or of the oldest voice of the sound when its limit is reached.
+	//! @returns INDEX_NONE - If the sound should not be played.
+	int32 FindVoice(const USoundBase* Sound) const;
+
+	//! Sounds requested in the current frame
+	TArray<FSfxRequest> Requests;
+
+	//! World time each voice started playing at
+	TArray<float> VoiceStartTimes;
+
+	//Hidden properties
+
+	//! The pre-allocated voices
+	UPROPERTY()
+		TArray<UAudioComponent*> Voices;
+};
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//! @brief Director deciding when the pond population grows or shrinks, based on the recent frame time
+//! The slower of the game and render thread times is smoothed and compared to the frame budget:
+//! over the budget the target population drops by a fraction, with enough headroom it grows by a step.
+//! Fish are added or sent away one at a time, faster the emptier the pond is compared to the target.
+class UE5_AR_API FSpawnDirector
+{
+public:
+
+	// Functions
+
+	//! @brief Function setting up the director, restarts from the middle of the population range
+	//! @param InMinPopulation - Population kept regardless of the frame time.
+	//! @param InMaxPopulation - Population never exceeded.
+	//! @param InSpawnInterval - Time between two population changes with the pond at its target.
+	//! @param InFrameBudget - Targeted frame time in milliseconds.
+	void Reset(const int32 InMinPopulation, const int32 InMaxPopulation, const float InSpawnInterval, const float InFrameBudget);
+
+	//! @brief Update function measuring the frame and deciding the population change
+	//! @param DeltaTime - Time between frames.
+	//! @param FrameTime - Time of the last frame in milliseconds, see MeasureFrameTime().
+	//! @param Population - Current number of fish not leaving the pond.
+	//! @returns 1 - If a fish should be spawned.
+	//! @returns -1 - If a fish should be sent away.
+	//! @returns 0 - otherwise.
+	int32 Update(const float DeltaTime, const float FrameTime, const int32 Population);
+
+	//! @brief Function returning the population the director currently aims for
+	//! @returns [value] - Number of fish between the minimum and the maximum population.
+	int32 GetTargetPopulation() const { return FMath::RoundToInt(TargetPopulation); }
+
+	//! @brief Function returning the time the last frame took on the busier of the game and render threads
+	//! @returns [value] - Frame time in milliseconds.
+	static float MeasureFrameTime();
+
+	// Constants
+
+	//! Weight of the latest frame in the smoothed frame time
+	static constexpr float FrameTimeSmoothing = 0.1f;
+
+	//! Time between two adjustments of the target population, gives the smoothed frame time time to react
+	static constexpr float AdjustInterval = 1.f;
+
+	//! Fraction of the budget under which the population grows
+	static constexpr float HeadroomLoad = 0.8f;
+
+	//! Factor applied to the target population over the budget
+	static constexpr float DecreaseFactor = 0.8f;
+
+	//! Fraction of the target population added with enough headroom, at least one fish
+	static constexpr float IncreaseFraction = 0.1f;
+
+	//! Shortest spawn interval relative to the base one, used while the pond is nearly empty
+	static constexpr float MinSpawnIntervalScale = 0.25f;
+
+protected:
+
+	//Hidden
+
+	int32 MinPopulation = 0;
+	int32 MaxPopulation = 0;
+	float SpawnInterval = 1.f;
+	float FrameBudget = 33.f;
+
+	//! Population the director aims for, fractional so small increases add up
+	float TargetPopulation = 0.f;
+
+	//! Exponential moving average of the frame time in milliseconds
+	float SmoothedFrameTime = 0.f;
+
+	//! Time since the last adjustment of the target population
+	float AdjustTimer = 0.f;
+
+	//! Time since the last population change
+	float SpawnTimer = 0.f;
+};